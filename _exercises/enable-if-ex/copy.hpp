@@ -0,0 +1,163 @@
+#ifndef COPY_HPP
+#define COPY_HPP
+
+#include <algorithm>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define COPY_HAS_STREAMING_STORES
+#endif
+
+#if defined(__linux__)
+#include <unistd.h>
+#endif
+
+namespace Exercise
+{
+    enum class Implementation {
+        Generic,   // element by element
+        Optimized, // memmove
+        Streaming, // non-temporal stores - bypass the cache for copies larger than LLC
+        Parallel   // chunks copied by many threads
+    };
+
+    namespace Details
+    {
+        inline std::size_t last_level_cache_size()
+        {
+#if defined(__linux__) && defined(_SC_LEVEL3_CACHE_SIZE)
+            if (long size = ::sysconf(_SC_LEVEL3_CACHE_SIZE); size > 0)
+                return static_cast<std::size_t>(size);
+#endif
+            return 32 * 1024 * 1024;
+        }
+    } // namespace Details
+
+    // tunable - tests & benchmarks may change them
+    struct CopyThresholds
+    {
+        std::size_t streaming_min_bytes = Details::last_level_cache_size();
+        std::size_t parallel_min_bytes = std::size_t{1} << 30;
+        unsigned max_threads = std::max(1u, std::thread::hardware_concurrency());
+    };
+
+    // set-once configuration - read without synchronization by copy(), so change it only while no copy is running
+    inline CopyThresholds copy_thresholds;
+
+    template <typename InputIterator, typename OutputIterator>
+    concept BitwiseCopyable = std::contiguous_iterator<InputIterator>
+        && std::contiguous_iterator<OutputIterator>
+        && std::same_as<std::iter_value_t<InputIterator>, std::iter_value_t<OutputIterator>>
+        && std::is_trivially_copyable_v<std::iter_value_t<InputIterator>>
+        && std::indirectly_writable<OutputIterator, std::iter_reference_t<InputIterator>>;
+
+    namespace Details
+    {
+#ifdef COPY_HAS_STREAMING_STORES
+        // dest & src must not overlap
+        inline void stream_copy(std::byte* dest, const std::byte* src, std::size_t size)
+        {
+            const std::size_t head = std::min(size, (16 - reinterpret_cast<std::uintptr_t>(dest) % 16) % 16);
+            std::memcpy(dest, src, head);
+            dest += head;
+            src += head;
+            size -= head;
+
+            for (; size >= 64; size -= 64, dest += 64, src += 64)
+            {
+                const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src));
+                const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + 16));
+                const __m128i c = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + 32));
+                const __m128i d = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + 48));
+                _mm_stream_si128(reinterpret_cast<__m128i*>(dest), a);
+                _mm_stream_si128(reinterpret_cast<__m128i*>(dest + 16), b);
+                _mm_stream_si128(reinterpret_cast<__m128i*>(dest + 32), c);
+                _mm_stream_si128(reinterpret_cast<__m128i*>(dest + 48), d);
+            }
+
+            std::memcpy(dest, src, size);
+            _mm_sfence(); // streaming stores are weakly ordered
+        }
+#else
+        inline void stream_copy(std::byte* dest, const std::byte* src, std::size_t size)
+        {
+            std::memcpy(dest, src, size);
+        }
+#endif
+
+        inline void parallel_copy(std::byte* dest, const std::byte* src, std::size_t size, unsigned thread_count)
+        {
+            constexpr std::size_t alignment = 64; // chunk size - multiple of a cache line
+            const std::size_t chunk_size = (size / thread_count + alignment - 1) / alignment * alignment;
+
+            std::vector<std::jthread> threads;
+            threads.reserve(thread_count - 1);
+
+            for (std::size_t offset = chunk_size; offset < size; offset += chunk_size)
+            {
+                const std::size_t count = std::min(chunk_size, size - offset);
+                threads.emplace_back([=] { stream_copy(dest + offset, src + offset, count); });
+            }
+
+            stream_copy(dest, src, std::min(chunk_size, size));
+        }
+
+        inline bool overlap(const std::byte* dest, const std::byte* src, std::size_t size)
+        {
+            return std::less<>{}(dest, src + size) && std::less<>{}(src, dest + size);
+        }
+    } // namespace Details
+
+    template <typename InputIterator, typename OutputIterator>
+    Implementation copy(InputIterator start, InputIterator end, OutputIterator dest)
+    {
+        for (auto it = start; it != end; ++it, ++dest)
+        {
+            *dest = *it;
+        }
+
+        return Implementation::Generic;
+    }
+
+    template <typename InputIterator, typename OutputIterator>
+        requires BitwiseCopyable<InputIterator, OutputIterator>
+    Implementation copy(InputIterator start, InputIterator end, OutputIterator dest)
+    {
+        const std::size_t size = static_cast<std::size_t>(end - start) * sizeof(std::iter_value_t<InputIterator>);
+
+        if (size == 0)
+            return Implementation::Optimized;
+
+        auto* dest_bytes = reinterpret_cast<std::byte*>(std::to_address(dest));
+        const auto* src_bytes = reinterpret_cast<const std::byte*>(std::to_address(start));
+
+        const CopyThresholds& thresholds = copy_thresholds;
+
+        if (size < thresholds.streaming_min_bytes || Details::overlap(dest_bytes, src_bytes, size))
+        {
+            std::memmove(dest_bytes, src_bytes, size);
+            return Implementation::Optimized;
+        }
+
+        if (size >= thresholds.parallel_min_bytes && thresholds.max_threads > 1)
+        {
+            Details::parallel_copy(dest_bytes, src_bytes, size, thresholds.max_threads);
+            return Implementation::Parallel;
+        }
+
+        Details::stream_copy(dest_bytes, src_bytes, size);
+        return Implementation::Streaming;
+    }
+} // namespace Exercise
+
+#endif
@@ -1,30 +1,18 @@
+#include "copy.hpp"
+#include "noexcept_audit.hpp"
+
+#include <catch2/benchmark/catch_benchmark.hpp>
 #include <catch2/catch_test_macros.hpp>
+#include <algorithm>
+#include <cstddef>
 #include <iostream>
 #include <list>
+#include <memory>
+#include <new>
+#include <numeric>
 #include <string>
 #include <vector>
 
-namespace Exercise
-{
-    enum class Implementation {
-        Generic,
-        Optimized
-    };
-
-    template <typename InputIterator, typename OutputIterator>
-    Implementation copy(InputIterator start, InputIterator end, OutputIterator dest)
-    {
-        for (auto it = start; it != end; ++it, ++dest)
-        {
-            *dest = *it;
-        }
-
-        return Implementation::Generic;
-    }
-} // namespace Exercise
-
-// TODO - optimized version with memcpy of copy
-
 TEST_CASE("copy algorithm")
 {
     using Exercise::Implementation;
@@ -48,12 +36,130 @@ TEST_CASE("copy algorithm")
         REQUIRE(std::equal(begin(words), end(words), begin(dest), end(dest)));
     }
 
-    // SECTION("optimized for arrays of POD types")
-    // {
-    //     int tab1[5] = {1, 2, 3, 4, 5};
-    //     int tab2[5];
+    SECTION("optimized for arrays of POD types")
+    {
+        int tab1[5] = {1, 2, 3, 4, 5};
+        int tab2[5];
+
+        REQUIRE(Exercise::copy(begin(tab1), end(tab1), begin(tab2)) == Implementation::Optimized);
+        REQUIRE(std::equal(begin(tab1), end(tab1), begin(tab2), end(tab2)));
+    }
+
+    SECTION("optimized for vectors of POD types")
+    {
+        std::vector<double> vec = {1.0, 2.0, 3.0};
+        std::vector<double> dest(3);
+
+        REQUIRE(Exercise::copy(vec.begin(), vec.end(), dest.begin()) == Implementation::Optimized);
+        REQUIRE(vec == dest);
+    }
+
+    SECTION("optimized for overlapping ranges")
+    {
+        int tab[6] = {1, 2, 3, 4, 5, 6};
+
+        REQUIRE(Exercise::copy(begin(tab) + 2, end(tab), begin(tab)) == Implementation::Optimized);
+
+        const int expected[] = {3, 4, 5, 6, 5, 6};
+        REQUIRE(std::equal(begin(tab), end(tab), begin(expected), end(expected)));
+    }
+
+    SECTION("generic when value types differ")
+    {
+        int tab1[3] = {1, 2, 3};
+        long tab2[3];
+
+        REQUIRE(Exercise::copy(begin(tab1), end(tab1), begin(tab2)) == Implementation::Generic);
+        REQUIRE(std::equal(begin(tab1), end(tab1), begin(tab2), end(tab2)));
+    }
+}
+
+TEST_CASE("copy thresholds - trivially copyable")
+{
+    using Members = Helpers::SpecialMembers<Exercise::CopyThresholds>;
+
+    static_assert(Members::copy_constructor == Helpers::MemberGuarantee::trivial);
+    static_assert(Members::copy_assignment == Helpers::MemberGuarantee::trivial);
+}
+
+namespace
+{
+    // restores Exercise::copy_thresholds when a test ends (also by a failed REQUIRE)
+    class ScopedCopyThresholds
+    {
+        const Exercise::CopyThresholds saved_ = Exercise::copy_thresholds;
+
+    public:
+        ScopedCopyThresholds() = default;
+        ScopedCopyThresholds(const ScopedCopyThresholds&) = delete;
+        ScopedCopyThresholds& operator=(const ScopedCopyThresholds&) = delete;
+
+        ~ScopedCopyThresholds()
+        {
+            Exercise::copy_thresholds = saved_;
+        }
+    };
+} // namespace
+
+TEST_CASE("copy algorithm - large ranges")
+{
+    using Exercise::Implementation;
+
+    ScopedCopyThresholds thresholds_guard;
+
+    // sizes not aligned to the SIMD block & misaligned destination
+    std::vector<int> src(100'003);
+    std::iota(src.begin(), src.end(), 0);
+    std::vector<int> dest(src.size() + 1);
+
+    SECTION("streaming stores above LLC size")
+    {
+        Exercise::copy_thresholds.streaming_min_bytes = 1024;
+
+        REQUIRE(Exercise::copy(src.begin(), src.end(), dest.begin() + 1) == Implementation::Streaming);
+        REQUIRE(std::equal(src.begin(), src.end(), dest.begin() + 1));
+    }
+
+    SECTION("parallel for huge ranges")
+    {
+        Exercise::copy_thresholds.streaming_min_bytes = 1024;
+        Exercise::copy_thresholds.parallel_min_bytes = 4096;
+        Exercise::copy_thresholds.max_threads = 7;
+
+        REQUIRE(Exercise::copy(src.begin(), src.end(), dest.begin() + 1) == Implementation::Parallel);
+        REQUIRE(std::equal(src.begin(), src.end(), dest.begin() + 1));
+    }
+}
+
+TEST_CASE("copy - memmove/streaming/parallel vs. std::copy", "[.benchmark]")
+{
+    for (std::size_t size = 64; size <= (std::size_t{4} << 30); size *= 4)
+    {
+        std::unique_ptr<std::byte[]> src;
+        std::unique_ptr<std::byte[]> dest;
+
+        try
+        {
+            src = std::make_unique_for_overwrite<std::byte[]>(size);
+            dest = std::make_unique_for_overwrite<std::byte[]>(size);
+        }
+        catch (const std::bad_alloc&)
+        {
+            WARN("Skipping " << size << " bytes - not enough memory");
+            continue;
+        }
+
+        std::fill_n(src.get(), size, std::byte{42});
+        std::fill_n(dest.get(), size, std::byte{0}); // page faults outside of the measurement
 
-    //     REQUIRE(Exercise::copy(begin(tab1), end(tab1), begin(tab2)) == Implementation::Optimized);
-    //     REQUIRE(std::equal(begin(tab1), end(tab1), begin(tab2), end(tab2)));
-    // }
+        BENCHMARK("std::copy - " + std::to_string(size) + " B")
+        {
+            return std::copy(src.get(), src.get() + size, dest.get());
+        };
+
+        BENCHMARK("Exercise::copy - " + std::to_string(size) + " B")
+        {
+            return Exercise::copy(src.get(), src.get() + size, dest.get());
+        };
+    }
 }
\ No newline at end of file
@@ -1,6 +1,8 @@
 #ifndef PARAGRAPH_HPP_
 #define PARAGRAPH_HPP_
 
+#include "relocation.hpp"
+
 #include <cstdlib>
 #include <cstring>
 #include <iostream>
@@ -53,12 +55,12 @@ namespace LegacyCode
             return *this;
         }
 
-        
-        Paragraph& operator=(Paragraph&& p)
+        Paragraph& operator=(Paragraph&& p) noexcept
         {
             if (this != &p)
             {
-                p = std::exchange(p.buffer_, nullptr);
+                delete[] buffer_;
+                buffer_ = std::exchange(p.buffer_, nullptr);
             }
 
             return *this;
@@ -86,6 +88,11 @@ namespace LegacyCode
     };
 }
 
+// owns a heap buffer through a pointer - its bytes can be moved by memcpy
+template <>
+struct Helpers::IsTriviallyRelocatable<LegacyCode::Paragraph> : std::true_type
+{};
+
 class Shape
 {
 public:
@@ -1,9 +1,13 @@
 
+#include "noexcept_audit.hpp"
 #include "paragraph.hpp"
+#include "relocating_vector.hpp"
 
 #include <catch2/catch_test_macros.hpp>
 #include <iostream>
 #include <memory>
+#include <string>
+#include <vector>
 
 using namespace std;
 
@@ -16,6 +20,48 @@ TEST_CASE("Moving paragraph")
     REQUIRE(txt.get_paragraph() == nullptr);
 }
 
+TEST_CASE("Move assignment of paragraph")
+{
+    LegacyCode::Paragraph txt("***");
+    LegacyCode::Paragraph target_txt("---");
+    target_txt = std::move(txt);
+
+    REQUIRE(target_txt.get_paragraph() == string("***"));
+    REQUIRE(txt.get_paragraph() == nullptr);
+}
+
+TEST_CASE("noexcept audit - shapes")
+{
+    static_assert(Helpers::assert_nothrow_movable<LegacyCode::Paragraph>());
+    static_assert(Helpers::assert_nothrow_movable<Text>());
+    static_assert(Helpers::assert_nothrow_movable<ShapeGroup>());
+
+    Helpers::ReallocationAudit audit;
+
+    {
+        std::vector<Text, Helpers::AuditingAllocator<Text>> texts{Helpers::AuditingAllocator<Text>{audit}};
+        for (int i = 0; i < 100; ++i)
+            texts.emplace_back(i, i, std::to_string(i));
+    }
+
+    REQUIRE(audit.copy_fallbacks == 0);
+}
+
+TEST_CASE("Relocating paragraphs")
+{
+    static_assert(Helpers::IsTriviallyRelocatable_v<LegacyCode::Paragraph>);
+
+    Helpers::RelocatingVector<LegacyCode::Paragraph> paragraphs;
+    for (int i = 0; i < 100; ++i)
+        paragraphs.emplace_back(std::to_string(i).c_str()); // grows by memcpy
+
+    paragraphs.erase(paragraphs.begin());
+
+    REQUIRE(paragraphs.size() == 99);
+    REQUIRE(paragraphs[0].get_paragraph() == string("1"));
+    REQUIRE(paragraphs[98].get_paragraph() == string("99"));
+}
+
 TEST_CASE("Moving text shape")
 {
     Text txt{10, 20, "text"};
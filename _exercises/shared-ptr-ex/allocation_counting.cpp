@@ -0,0 +1,79 @@
+#include "allocation_counting.hpp"
+
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+
+namespace AllocationCounting
+{
+    thread_local bool is_enabled = false;
+    thread_local int allocation_count = 0;
+} // namespace AllocationCounting
+
+namespace
+{
+    void* counted_allocate(std::size_t size) noexcept
+    {
+        if (AllocationCounting::is_enabled)
+            ++AllocationCounting::allocation_count;
+
+        return std::malloc(size == 0 ? 1 : size);
+    }
+} // namespace
+
+// all non-aligned forms are replaced - a form left to the runtime could be paired with std::free
+void* operator new(std::size_t size)
+{
+    if (void* p = counted_allocate(size))
+        return p;
+
+    throw std::bad_alloc{};
+}
+
+void* operator new[](std::size_t size)
+{
+    if (void* p = counted_allocate(size))
+        return p;
+
+    throw std::bad_alloc{};
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept
+{
+    return counted_allocate(size);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept
+{
+    return counted_allocate(size);
+}
+
+void operator delete(void* p) noexcept
+{
+    std::free(p);
+}
+
+void operator delete[](void* p) noexcept
+{
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept
+{
+    std::free(p);
+}
+
+void operator delete[](void* p, std::size_t) noexcept
+{
+    std::free(p);
+}
+
+void operator delete(void* p, const std::nothrow_t&) noexcept
+{
+    std::free(p);
+}
+
+void operator delete[](void* p, const std::nothrow_t&) noexcept
+{
+    std::free(p);
+}
@@ -0,0 +1,29 @@
+#ifndef ALLOCATION_COUNTING_HPP
+#define ALLOCATION_COUNTING_HPP
+
+// counts heap allocations (global operator new is replaced in allocation_counting.cpp)
+namespace AllocationCounting
+{
+    extern thread_local bool is_enabled;
+    extern thread_local int allocation_count;
+
+    // counts allocations of the current thread while alive
+    struct Scope
+    {
+        Scope()
+        {
+            allocation_count = 0;
+            is_enabled = true;
+        }
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+        ~Scope()
+        {
+            is_enabled = false;
+        }
+    };
+} // namespace AllocationCounting
+
+#endif
@@ -0,0 +1,253 @@
+#ifndef ASYNC_SUBJECT_HPP
+#define ASYNC_SUBJECT_HPP
+
+#include "observer.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <condition_variable>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <vector>
+
+enum class Coalescing
+{
+    disabled,    // every event is delivered
+    latest_state // only the latest event since the last drain is delivered
+};
+
+struct AsyncDispatchOptions
+{
+    std::size_t worker_count = 1;
+    std::size_t queue_capacity = 1024;
+    Coalescing coalescing = Coalescing::disabled;
+};
+
+// Subject that delivers events asynchronously
+//  - observers are spread over a pool of workers; each worker owns a bounded queue of events
+//  - a worker drains its queue and delivers a whole batch to each of its observers (per-observer order is kept)
+//  - with coalescing the producer only overwrites the pending event and never waits
+class AsyncSubject
+{
+    class Worker
+    {
+        const AsyncDispatchOptions& options_;
+
+        std::mutex mtx_;
+        std::condition_variable not_empty_;
+        std::condition_variable not_full_;
+        std::condition_variable idle_;
+
+        std::vector<StateChanged> queue_; // ring buffer
+        std::size_t head_{};
+        std::size_t size_{};
+        std::optional<StateChanged> latest_;
+        bool busy_{false};
+        bool stop_{false};
+
+        std::vector<std::shared_ptr<Observer>> observers_;
+        std::size_t observers_version_{};
+        std::atomic<std::size_t> observer_count_{};
+
+        std::thread thread_;
+
+        bool has_pending_events() const
+        {
+            return size_ > 0 || latest_.has_value();
+        }
+
+        void drain_to(std::vector<StateChanged>& batch)
+        {
+            batch.clear();
+
+            if (latest_)
+            {
+                batch.push_back(*latest_);
+                latest_.reset();
+            }
+
+            for (; size_ > 0; --size_)
+            {
+                batch.push_back(queue_[head_]);
+                head_ = (head_ + 1) % queue_.size();
+            }
+        }
+
+        void run()
+        {
+            std::vector<StateChanged> batch;
+            batch.reserve(queue_.size() + 1);
+
+            std::vector<std::shared_ptr<Observer>> observers;
+            std::size_t observers_version = 0;
+
+            while (true)
+            {
+                {
+                    std::unique_lock lk{mtx_};
+                    busy_ = false;
+                    idle_.notify_all();
+
+                    not_empty_.wait(lk, [this] { return stop_ || has_pending_events(); });
+
+                    if (!has_pending_events()) // stop_ requested and nothing left to deliver
+                        return;
+
+                    drain_to(batch);
+                    busy_ = true;
+
+                    if (observers_version != observers_version_)
+                    {
+                        observers = observers_;
+                        observers_version = observers_version_;
+                    }
+                }
+
+                not_full_.notify_all();
+
+                for (const auto& observer : observers)
+                    observer->update_batch(batch);
+            }
+        }
+
+    public:
+        explicit Worker(const AsyncDispatchOptions& options)
+            : options_{options}
+            , queue_(options.queue_capacity)
+        {
+            thread_ = std::thread{[this] { run(); }};
+        }
+
+        ~Worker()
+        {
+            {
+                std::lock_guard lk{mtx_};
+                stop_ = true;
+            }
+
+            not_empty_.notify_one();
+            thread_.join();
+        }
+
+        std::size_t observer_count() const
+        {
+            return observer_count_.load(std::memory_order_relaxed);
+        }
+
+        void add(std::shared_ptr<Observer> observer)
+        {
+            std::lock_guard lk{mtx_};
+            observers_.push_back(std::move(observer));
+            ++observers_version_;
+            observer_count_.store(observers_.size(), std::memory_order_relaxed);
+        }
+
+        bool remove(const Observer* observer)
+        {
+            std::lock_guard lk{mtx_};
+
+            const auto removed = std::erase_if(observers_, [observer](const auto& o) { return o.get() == observer; });
+            ++observers_version_;
+            observer_count_.store(observers_.size(), std::memory_order_relaxed);
+
+            return removed > 0;
+        }
+
+        void push(const StateChanged& event)
+        {
+            {
+                std::unique_lock lk{mtx_};
+
+                if (options_.coalescing == Coalescing::latest_state)
+                {
+                    latest_ = event;
+                }
+                else
+                {
+                    not_full_.wait(lk, [this] { return size_ < queue_.size(); });
+                    queue_[(head_ + size_) % queue_.size()] = event;
+                    ++size_;
+                }
+            }
+
+            not_empty_.notify_one();
+        }
+
+        void flush()
+        {
+            std::unique_lock lk{mtx_};
+            idle_.wait(lk, [this] { return !busy_ && !has_pending_events(); });
+        }
+    };
+
+    AsyncDispatchOptions options_;
+    std::atomic<int> state_{};
+    std::vector<std::unique_ptr<Worker>> workers_;
+
+public:
+    explicit AsyncSubject(AsyncDispatchOptions options = {})
+        : options_{options}
+    {
+        assert(options_.worker_count > 0 && options_.queue_capacity > 0);
+
+        workers_.reserve(options_.worker_count);
+        for (std::size_t i = 0; i < options_.worker_count; ++i)
+            workers_.push_back(std::make_unique<Worker>(options_));
+    }
+
+    AsyncSubject(const AsyncSubject&) = delete;
+    AsyncSubject& operator=(const AsyncSubject&) = delete;
+
+    // pending events are delivered before workers stop
+    ~AsyncSubject() = default;
+
+    // observer is assigned to the least loaded worker
+    void register_observer(std::shared_ptr<Observer> observer)
+    {
+        auto least_loaded = std::min_element(workers_.begin(), workers_.end(), [](const auto& a, const auto& b) {
+            return a->observer_count() < b->observer_count();
+        });
+
+        (*least_loaded)->add(std::move(observer));
+    }
+
+    // a batch already taken by a worker may still be delivered to the observer
+    void unregister_observer(const Observer* observer)
+    {
+        for (auto& worker : workers_)
+        {
+            if (worker->remove(observer))
+                return;
+        }
+    }
+
+    void set_state(int new_state)
+    {
+        if (state_.exchange(new_state) != new_state)
+        {
+            notify(StateChanged{new_state});
+        }
+    }
+
+    void notify(const StateChanged& event)
+    {
+        for (auto& worker : workers_)
+        {
+            if (worker->observer_count() > 0)
+                worker->push(event);
+        }
+    }
+
+    // waits until all events pushed so far are delivered
+    void flush()
+    {
+        for (auto& worker : workers_)
+            worker->flush();
+    }
+};
+
+#endif
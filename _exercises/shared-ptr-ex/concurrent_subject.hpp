@@ -0,0 +1,197 @@
+#ifndef CONCURRENT_SUBJECT_HPP
+#define CONCURRENT_SUBJECT_HPP
+
+#include "observer.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// Subject safe to notify from many threads
+//  - registry is an immutable, contiguous snapshot of weak_ptrs - observers that died are skipped
+//  - notify() never takes a lock: it marks itself as a reader and walks the current snapshot
+//  - register/unregister copy the snapshot, publish a new one and retire the old one;
+//    a retired snapshot is deleted once every reader that could still see it has left (RCU-like grace period)
+class ConcurrentSubject
+{
+    using Registry = std::vector<std::weak_ptr<Observer>>;
+
+    static constexpr std::size_t reader_stripes = 16;
+
+    struct alignas(64) ReaderCounter
+    {
+        std::atomic<std::int64_t> count{};
+    };
+
+    struct RetiredRegistry
+    {
+        const Registry* registry;
+        unsigned pending_parities; // parities of reader counters not yet seen drained since retirement
+    };
+
+    class ReadGuard
+    {
+        ReaderCounter& counter_;
+
+    public:
+        explicit ReadGuard(ReaderCounter& counter)
+            : counter_{counter}
+        {
+            counter_.count.fetch_add(1, std::memory_order_seq_cst);
+        }
+
+        ReadGuard(const ReadGuard&) = delete;
+        ReadGuard& operator=(const ReadGuard&) = delete;
+
+        ~ReadGuard()
+        {
+            counter_.count.fetch_sub(1, std::memory_order_release);
+        }
+    };
+
+    std::atomic<int> state_{};
+    std::atomic<const Registry*> registry_;
+    std::atomic<std::uint64_t> epoch_{};
+    mutable ReaderCounter readers_[2][reader_stripes];
+
+    std::mutex writer_mtx_; // serializes writers only - readers never touch it
+    std::vector<RetiredRegistry> retired_;
+
+    static std::size_t reader_stripe()
+    {
+        static std::atomic<std::size_t> next_stripe{};
+        thread_local const std::size_t stripe = next_stripe.fetch_add(1, std::memory_order_relaxed) % reader_stripes;
+        return stripe;
+    }
+
+    bool readers_drained(std::size_t parity) const
+    {
+        for (const auto& counter : readers_[parity])
+        {
+            if (counter.count.load(std::memory_order_seq_cst) != 0)
+                return false;
+        }
+
+        return true;
+    }
+
+    // writer_mtx_ must be held
+    void publish(std::unique_ptr<Registry> updated)
+    {
+        const Registry* old = registry_.exchange(updated.release(), std::memory_order_seq_cst);
+        retired_.push_back(RetiredRegistry{old, 0b11});
+
+        reclaim();
+    }
+
+    // writer_mtx_ must be held
+    void reclaim()
+    {
+        // new readers move to the other parity, so the current one drains
+        epoch_.fetch_add(1, std::memory_order_seq_cst);
+
+        // every reader that could see a retired registry was counted before it was retired;
+        // seeing a parity at zero afterwards means all such readers of that parity have left
+        for (std::size_t parity = 0; parity < 2; ++parity)
+        {
+            if (readers_drained(parity))
+            {
+                for (auto& retired : retired_)
+                    retired.pending_parities &= ~(1u << parity);
+            }
+        }
+
+        std::erase_if(retired_, [](const RetiredRegistry& retired) {
+            if (retired.pending_parities != 0)
+                return false;
+
+            delete retired.registry;
+            return true;
+        });
+    }
+
+    template <typename Predicate>
+    std::unique_ptr<Registry> copy_registry_if(Predicate keep) const
+    {
+        const Registry* current = registry_.load(std::memory_order_relaxed);
+
+        auto updated = std::make_unique<Registry>();
+        updated->reserve(current->size() + 1);
+
+        for (const auto& entry : *current)
+        {
+            if (!entry.expired() && keep(entry))
+                updated->push_back(entry);
+        }
+
+        return updated;
+    }
+
+public:
+    ConcurrentSubject()
+        : registry_{new Registry{}}
+    { }
+
+    ConcurrentSubject(const ConcurrentSubject&) = delete;
+    ConcurrentSubject& operator=(const ConcurrentSubject&) = delete;
+
+    // no notify() may run concurrently with destruction
+    ~ConcurrentSubject()
+    {
+        for (const auto& retired : retired_)
+            delete retired.registry;
+
+        delete registry_.load();
+    }
+
+    void register_observer(std::weak_ptr<Observer> observer)
+    {
+        std::lock_guard lk{writer_mtx_};
+
+        auto updated = copy_registry_if([](const auto&) { return true; });
+        updated->push_back(std::move(observer));
+
+        publish(std::move(updated));
+    }
+
+    void unregister_observer(const Observer* observer)
+    {
+        std::lock_guard lk{writer_mtx_};
+
+        publish(copy_registry_if([observer](const std::weak_ptr<Observer>& entry) { return entry.lock().get() != observer; }));
+    }
+
+    std::size_t observer_count() const
+    {
+        ReadGuard guard{readers_[epoch_.load(std::memory_order_seq_cst) & 1][reader_stripe()]};
+        return registry_.load(std::memory_order_seq_cst)->size();
+    }
+
+    void set_state(int new_state)
+    {
+        if (state_.exchange(new_state) != new_state)
+        {
+            notify(StateChanged{new_state});
+        }
+    }
+
+    // wait-free for the subject - never blocks on writers
+    void notify(const StateChanged& event)
+    {
+        ReadGuard guard{readers_[epoch_.load(std::memory_order_seq_cst) & 1][reader_stripe()]};
+
+        const Registry* registry = registry_.load(std::memory_order_seq_cst);
+
+        for (const auto& entry : *registry)
+        {
+            if (auto observer = entry.lock())
+                observer->update(event);
+        }
+    }
+};
+
+#endif
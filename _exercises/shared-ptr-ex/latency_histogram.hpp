@@ -0,0 +1,138 @@
+#ifndef LATENCY_HISTOGRAM_HPP
+#define LATENCY_HISTOGRAM_HPP
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+#if defined(_M_X64)
+#include <intrin.h>
+#define LATENCY_HISTOGRAM_HAS_RDTSC
+#elif defined(__x86_64__)
+#include <x86intrin.h>
+#define LATENCY_HISTOGRAM_HAS_RDTSC
+#endif
+
+namespace Instrumentation
+{
+    // cheap timestamp - TSC ticks on x86-64, nanoseconds elsewhere
+    inline std::uint64_t ticks()
+    {
+#ifdef LATENCY_HISTOGRAM_HAS_RDTSC
+        return __rdtsc();
+#else
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+    }
+
+    // measured once - used only when reading histograms, never when recording
+    inline double ticks_per_ns()
+    {
+#ifdef LATENCY_HISTOGRAM_HAS_RDTSC
+        static const double value = [] {
+            const auto start_time = std::chrono::steady_clock::now();
+            const auto start_ticks = ticks();
+
+            while (std::chrono::steady_clock::now() - start_time < std::chrono::milliseconds{10})
+            { }
+
+            const auto elapsed = std::chrono::steady_clock::now() - start_time;
+            return static_cast<double>(ticks() - start_ticks) / std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count();
+        }();
+
+        return value;
+#else
+        return 1.0;
+#endif
+    }
+
+    inline std::chrono::nanoseconds to_duration(std::uint64_t ticks)
+    {
+        return std::chrono::nanoseconds{static_cast<std::int64_t>(ticks / ticks_per_ns())};
+    }
+
+    // log2-bucketed histogram of tick counts: bucket 0 - [0], bucket i - [2^(i-1), 2^i)
+    class LatencyHistogram
+    {
+    public:
+        static constexpr std::size_t bucket_count = 48;
+
+    private:
+        std::array<std::uint64_t, bucket_count> buckets_{};
+        std::uint64_t count_{};
+        std::uint64_t max_{};
+
+        static std::size_t bucket_of(std::uint64_t ticks)
+        {
+            return std::min<std::size_t>(std::bit_width(ticks), bucket_count - 1);
+        }
+
+    public:
+        void record(std::uint64_t ticks)
+        {
+            ++buckets_[bucket_of(ticks)];
+            ++count_;
+            max_ = std::max(max_, ticks);
+        }
+
+        std::uint64_t count() const
+        {
+            return count_;
+        }
+
+        std::uint64_t max() const
+        {
+            return max_;
+        }
+
+        const std::array<std::uint64_t, bucket_count>& buckets() const
+        {
+            return buckets_;
+        }
+
+        // upper bound (in ticks) of the bucket holding given percentile
+        std::uint64_t percentile(double p) const
+        {
+            if (count_ == 0)
+                return 0;
+
+            const auto rank = static_cast<std::uint64_t>(p / 100.0 * (count_ - 1)) + 1;
+
+            std::uint64_t seen = 0;
+            for (std::size_t i = 0; i < bucket_count; ++i)
+            {
+                seen += buckets_[i];
+                if (seen >= rank)
+                    return std::min(max_, (std::uint64_t{1} << i) - 1);
+            }
+
+            return max_;
+        }
+    };
+
+    struct LatencyStats
+    {
+        std::uint64_t count;
+        std::chrono::nanoseconds p50;
+        std::chrono::nanoseconds p99;
+        std::chrono::nanoseconds max;
+        bool over_budget;
+    };
+
+    inline LatencyStats stats_of(const LatencyHistogram& histogram, std::chrono::nanoseconds p99_budget)
+    {
+        const auto p99 = to_duration(histogram.percentile(99.0));
+
+        return LatencyStats{
+            histogram.count(),
+            to_duration(histogram.percentile(50.0)),
+            p99,
+            to_duration(histogram.max()),
+            p99 > p99_budget};
+    }
+} // namespace Instrumentation
+
+#endif
@@ -0,0 +1,79 @@
+#ifndef OBSERVER_HPP
+#define OBSERVER_HPP
+
+#include <charconv>
+#include <span>
+#include <string>
+#include <type_traits>
+
+// events are small, trivially copyable structs passed by reference - formatting is done only on demand
+struct StateChanged
+{
+    int state;
+};
+
+static_assert(std::is_trivially_copyable_v<StateChanged>);
+
+inline void format_to(std::string& out, const StateChanged& event)
+{
+    char digits[16];
+    auto [end, ec] = std::to_chars(digits, digits + sizeof(digits), event.state);
+
+    out.assign("Changed state on: ");
+    out.append(digits, end);
+}
+
+inline std::string to_string(const StateChanged& event)
+{
+    std::string text;
+    format_to(text, event);
+    return text;
+}
+
+class Observer
+{
+public:
+    // adapter for observers interested only in a text - formats lazily into a per-thread buffer
+    // (a nested notification from inside update() gets its own string)
+    virtual void update(const StateChanged& event)
+    {
+        thread_local std::string buffer;
+        thread_local bool buffer_in_use = false;
+
+        if (buffer_in_use)
+        {
+            update(to_string(event));
+            return;
+        }
+
+        struct BufferGuard
+        {
+            bool& in_use;
+
+            ~BufferGuard()
+            {
+                in_use = false;
+            }
+        };
+
+        buffer_in_use = true;
+        BufferGuard guard{buffer_in_use};
+
+        format_to(buffer, event);
+        update(buffer);
+    }
+
+    // not pure - observers overriding only the typed update() are concrete; the text is ignored by default
+    virtual void update(const std::string& /*event_args*/) { }
+
+    // events delivered together by an asynchronous dispatcher - oldest first
+    virtual void update_batch(std::span<const StateChanged> events)
+    {
+        for (const auto& event : events)
+            update(event);
+    }
+
+    virtual ~Observer() = default;
+};
+
+#endif
@@ -0,0 +1,91 @@
+#ifndef STATIC_SUBJECT_HPP
+#define STATIC_SUBJECT_HPP
+
+#include "observer.hpp"
+
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+template <typename T>
+concept StaticObserver = requires(T& observer, const StateChanged& event) {
+    observer.update(event);
+};
+
+template <typename T>
+concept StaticObserverSlot = StaticObserver<T> || (std::is_pointer_v<T> && StaticObserver<std::remove_pointer_t<T>>);
+
+// Subject with a set of observers fixed at compile time
+//  - observers are stored in a tuple (by value or as non-owning pointers)
+//  - notify() is a fold expression over the tuple - no virtual calls, no container traversal
+template <StaticObserverSlot... TObservers>
+class StaticSubject
+{
+    int state_{};
+    std::tuple<TObservers...> observers_;
+
+    template <typename TObserver>
+    static void notify_one(TObserver& observer, const StateChanged& event)
+    {
+        if constexpr (std::is_pointer_v<TObserver>)
+        {
+            if (observer)
+                observer->update(event);
+        }
+        else
+        {
+            observer.update(event);
+        }
+    }
+
+public:
+    StaticSubject() = default;
+
+    explicit StaticSubject(TObservers... observers)
+        : observers_{std::move(observers)...}
+    { }
+
+    // for slots holding pointers - binds an observer to its slot
+    template <typename TObserver>
+    void register_observer(TObserver* observer)
+    {
+        std::get<TObserver*>(observers_) = observer;
+    }
+
+    template <typename TObserver>
+    void unregister_observer(TObserver*)
+    {
+        std::get<TObserver*>(observers_) = nullptr;
+    }
+
+    template <typename TObserver>
+    TObserver& observer()
+    {
+        return std::get<TObserver>(observers_);
+    }
+
+    template <std::size_t Index>
+    auto& observer()
+    {
+        return std::get<Index>(observers_);
+    }
+
+    void set_state(int new_state)
+    {
+        if (state_ != new_state)
+        {
+            state_ = new_state;
+            notify(StateChanged{state_});
+        }
+    }
+
+    void notify(const StateChanged& event)
+    {
+        std::apply([&event](auto&... observers) { (notify_one(observers, event), ...); }, observers_);
+    }
+};
+
+template <typename... TObservers>
+StaticSubject(TObservers...) -> StaticSubject<TObservers...>;
+
+#endif
@@ -0,0 +1,219 @@
+#include "async_subject.hpp"
+#include "noexcept_audit.hpp"
+
+#include <algorithm>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    class RecordingObserver : public Observer
+    {
+        std::mutex mtx_;
+        std::vector<int> states_;
+        std::size_t batches_{};
+
+    public:
+        void update_batch(std::span<const StateChanged> events) override
+        {
+            std::lock_guard lk{mtx_};
+            ++batches_;
+            for (const auto& event : events)
+                states_.push_back(event.state);
+        }
+
+        std::vector<int> states()
+        {
+            std::lock_guard lk{mtx_};
+            return states_;
+        }
+
+        std::size_t batches()
+        {
+            std::lock_guard lk{mtx_};
+            return batches_;
+        }
+    };
+
+    class SlowObserver : public Observer
+    {
+        std::chrono::microseconds delay_;
+
+    public:
+        std::atomic<int> last_state{};
+
+        explicit SlowObserver(std::chrono::microseconds delay)
+            : delay_{delay}
+        { }
+
+        void update(const StateChanged& event) override
+        {
+            auto until = std::chrono::steady_clock::now() + delay_;
+            while (std::chrono::steady_clock::now() < until)
+            { } // busy work
+
+            last_state = event.state;
+        }
+    };
+} // namespace
+
+TEST_CASE("AsyncSubject - not movable")
+{
+    using Members = Helpers::SpecialMembers<AsyncSubject>;
+
+    static_assert(Members::move_constructor == Helpers::MemberGuarantee::deleted);
+    static_assert(Members::destructor == Helpers::MemberGuarantee::nothrow);
+
+    static_assert(Helpers::SpecialMembers<AsyncDispatchOptions>::copy_constructor == Helpers::MemberGuarantee::trivial);
+}
+
+TEST_CASE("AsyncSubject - delivers every event in order")
+{
+    AsyncSubject subject{AsyncDispatchOptions{.worker_count = 2, .queue_capacity = 8}};
+
+    auto o1 = std::make_shared<RecordingObserver>();
+    auto o2 = std::make_shared<RecordingObserver>();
+    subject.register_observer(o1);
+    subject.register_observer(o2);
+
+    std::vector<int> expected;
+    for (int state = 1; state <= 100; ++state)
+    {
+        subject.set_state(state);
+        expected.push_back(state);
+    }
+
+    subject.flush();
+
+    REQUIRE(o1->states() == expected);
+    REQUIRE(o2->states() == expected);
+    REQUIRE(o1->batches() <= expected.size());
+}
+
+TEST_CASE("AsyncSubject - string observers work through adapter")
+{
+    class TextObserver : public Observer
+    {
+    public:
+        std::string last_event;
+
+        using Observer::update;
+
+        void update(const std::string& event) override
+        {
+            last_event = event;
+        }
+    };
+
+    AsyncSubject subject;
+
+    auto o = std::make_shared<TextObserver>();
+    subject.register_observer(o);
+
+    subject.set_state(7);
+    subject.flush();
+
+    REQUIRE(o->last_event == "Changed state on: 7");
+}
+
+TEST_CASE("AsyncSubject - coalescing delivers the latest state")
+{
+    AsyncSubject subject{AsyncDispatchOptions{.coalescing = Coalescing::latest_state}};
+
+    auto slow = std::make_shared<SlowObserver>(std::chrono::milliseconds{5});
+    auto recording = std::make_shared<RecordingObserver>();
+    subject.register_observer(slow);
+    subject.register_observer(recording);
+
+    for (int state = 1; state <= 100; ++state)
+        subject.set_state(state);
+
+    subject.flush();
+
+    auto states = recording->states();
+    REQUIRE(states.size() < 100);
+    REQUIRE(std::is_sorted(states.begin(), states.end()));
+    REQUIRE(states.back() == 100);
+    REQUIRE(slow->last_state == 100);
+}
+
+TEST_CASE("AsyncSubject - unregistered observer gets no new events")
+{
+    AsyncSubject subject;
+
+    auto o = std::make_shared<RecordingObserver>();
+    subject.register_observer(o);
+
+    subject.set_state(1);
+    subject.flush();
+
+    subject.unregister_observer(o.get());
+    subject.set_state(2);
+    subject.flush();
+
+    REQUIRE(o->states() == std::vector<int>{1});
+}
+
+TEST_CASE("AsyncSubject - producer latency & throughput", "[.benchmark]")
+{
+    using namespace std::chrono_literals;
+
+    constexpr int events = 10'000;
+
+    auto produce = [](AsyncSubject& subject, int& state) {
+        for (int i = 0; i < events; ++i)
+            subject.set_state(++state);
+    };
+
+    SECTION("1 fast observer")
+    {
+        AsyncSubject subject;
+        subject.register_observer(std::make_shared<RecordingObserver>());
+        int state = 0;
+
+        BENCHMARK("10'000 x set_state")
+        {
+            produce(subject, state);
+        };
+
+        subject.flush();
+    }
+
+    SECTION("100 slow observers")
+    {
+        for (auto coalescing : {Coalescing::disabled, Coalescing::latest_state})
+        {
+            AsyncSubject subject{AsyncDispatchOptions{.worker_count = 4, .coalescing = coalescing}};
+            for (int i = 0; i < 100; ++i)
+                subject.register_observer(std::make_shared<SlowObserver>(2us));
+            int state = 0;
+
+            BENCHMARK(coalescing == Coalescing::disabled ? "10'000 x set_state - all events" : "10'000 x set_state - coalescing")
+            {
+                produce(subject, state);
+            };
+
+            std::vector<std::chrono::nanoseconds> latencies;
+            latencies.reserve(events);
+            for (int i = 0; i < events; ++i)
+            {
+                auto start = std::chrono::steady_clock::now();
+                subject.set_state(++state);
+                latencies.push_back(std::chrono::steady_clock::now() - start);
+            }
+
+            std::sort(latencies.begin(), latencies.end());
+            std::cout << "set_state latency - p50: " << latencies[events / 2].count() << "ns"
+                      << ", p99: " << latencies[events * 99 / 100].count() << "ns"
+                      << ", max: " << latencies.back().count() << "ns\n";
+
+            subject.flush();
+        }
+    }
+}
@@ -0,0 +1,192 @@
+#include "concurrent_subject.hpp"
+#include "noexcept_audit.hpp"
+
+#include <atomic>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    class CountingObserver : public Observer
+    {
+    public:
+        std::atomic<int> counter{};
+        std::string last_event;
+
+        using Observer::update;
+
+        void update(const std::string& event_args) override
+        {
+            if (counter.fetch_add(1) == 0)
+                last_event = event_args;
+        }
+    };
+
+    class SelfUnregisteringObserver : public Observer
+    {
+        ConcurrentSubject& subject_;
+
+    public:
+        int counter{};
+
+        explicit SelfUnregisteringObserver(ConcurrentSubject& subject)
+            : subject_{subject}
+        { }
+
+        using Observer::update;
+
+        void update(const std::string&) override
+        {
+            ++counter;
+            subject_.unregister_observer(this);
+        }
+    };
+} // namespace
+
+TEST_CASE("ConcurrentSubject - not movable")
+{
+    using Members = Helpers::SpecialMembers<ConcurrentSubject>;
+
+    static_assert(Members::copy_constructor == Helpers::MemberGuarantee::deleted);
+    static_assert(Members::move_constructor == Helpers::MemberGuarantee::deleted);
+    static_assert(Members::destructor == Helpers::MemberGuarantee::nothrow);
+}
+
+TEST_CASE("ConcurrentSubject - notifying observers")
+{
+    ConcurrentSubject subject;
+
+    auto o1 = std::make_shared<CountingObserver>();
+    auto o2 = std::make_shared<CountingObserver>();
+
+    subject.register_observer(o1);
+    subject.register_observer(o2);
+
+    subject.set_state(1);
+
+    REQUIRE(o1->counter == 1);
+    REQUIRE(o1->last_event == "Changed state on: 1");
+    REQUIRE(o2->counter == 1);
+
+    SECTION("same state is not notified")
+    {
+        subject.set_state(1);
+
+        REQUIRE(o1->counter == 1);
+    }
+
+    SECTION("unregistered observer is not notified")
+    {
+        subject.unregister_observer(o1.get());
+        subject.set_state(2);
+
+        REQUIRE(o1->counter == 1);
+        REQUIRE(o2->counter == 2);
+    }
+
+    SECTION("destroyed observer is skipped")
+    {
+        o1.reset();
+        subject.set_state(2);
+
+        REQUIRE(o2->counter == 2);
+    }
+}
+
+TEST_CASE("ConcurrentSubject - observer can unregister itself during notify")
+{
+    ConcurrentSubject subject;
+
+    auto o = std::make_shared<SelfUnregisteringObserver>(subject);
+    subject.register_observer(o);
+
+    subject.set_state(1);
+    subject.set_state(2);
+
+    REQUIRE(o->counter == 1);
+    REQUIRE(subject.observer_count() == 0);
+}
+
+TEST_CASE("ConcurrentSubject - notify with concurrent registrations")
+{
+    ConcurrentSubject subject;
+
+    auto permanent = std::make_shared<CountingObserver>();
+    subject.register_observer(permanent);
+
+    constexpr int notifier_count = 4;
+    constexpr int notifications = 10'000;
+
+    std::atomic<bool> done{false};
+
+    std::thread churn{[&] {
+        while (!done)
+        {
+            auto temporary = std::make_shared<CountingObserver>();
+            subject.register_observer(temporary);
+            subject.unregister_observer(temporary.get());
+        }
+    }};
+
+    std::vector<std::thread> notifiers;
+    for (int i = 0; i < notifier_count; ++i)
+        notifiers.emplace_back([&] {
+            for (int n = 0; n < notifications; ++n)
+                subject.notify(StateChanged{n});
+        });
+
+    for (auto& t : notifiers)
+        t.join();
+
+    done = true;
+    churn.join();
+
+    REQUIRE(permanent->counter == notifier_count * notifications);
+    REQUIRE(subject.observer_count() == 1);
+}
+
+TEST_CASE("ConcurrentSubject - 8 notifiers with observer churn", "[.benchmark]")
+{
+    constexpr int notifier_count = 8;
+    constexpr int notifications = 100'000;
+
+    ConcurrentSubject subject;
+
+    std::vector<std::shared_ptr<CountingObserver>> observers;
+    for (int i = 0; i < 16; ++i)
+    {
+        observers.push_back(std::make_shared<CountingObserver>());
+        subject.register_observer(observers.back());
+    }
+
+    BENCHMARK("8 x 100'000 notifications")
+    {
+        std::atomic<bool> done{false};
+
+        std::thread churn{[&] {
+            while (!done)
+            {
+                auto temporary = std::make_shared<CountingObserver>();
+                subject.register_observer(temporary);
+                subject.unregister_observer(temporary.get());
+            }
+        }};
+
+        std::vector<std::thread> notifiers;
+        for (int i = 0; i < notifier_count; ++i)
+            notifiers.emplace_back([&] {
+                for (int n = 0; n < notifications; ++n)
+                    subject.notify(StateChanged{n});
+            });
+
+        for (auto& t : notifiers)
+            t.join();
+
+        done = true;
+        churn.join();
+    };
+}
@@ -1,31 +1,70 @@
+#include "allocation_counting.hpp"
+#include "latency_histogram.hpp"
+#include "noexcept_audit.hpp"
+#include "observer.hpp"
+#include "small_function.hpp"
+#include "static_subject.hpp"
+
+#include <algorithm>
 #include <cassert>
+#include <chrono>
+#include <cstdint>
 #include <cstdlib>
+#include <functional>
 #include <iostream>
+#include <map>
+#include <memory>
 #include <set>
 #include <stdexcept>
 #include <string>
+#include <utility>
+#include <vector>
+#include <catch2/benchmark/catch_benchmark.hpp>
 #include <catch2/catch_test_macros.hpp>
 
-class Observer
+class Subject
 {
 public:
-    virtual void update(const std::string& event_args) = 0;
-    virtual ~Observer() = default;
-};
+    using Subscriber = Helpers::SmallFunction<void(const StateChanged&)>;
+    using SubscriptionId = std::size_t;
 
-class Subject
-{
+    static constexpr std::size_t default_subscriber_capacity = 16;
+
+#ifdef ENABLE_NOTIFY_INSTRUMENTATION
+    struct ObserverLatency
+    {
+        const Observer* observer;
+        Instrumentation::LatencyStats stats;
+    };
+#endif
+
+private:
     int state_;
+#ifdef ENABLE_NOTIFY_INSTRUMENTATION
+    std::map<Observer*, Instrumentation::LatencyHistogram> observers_;
+    std::chrono::nanoseconds p99_budget_{std::chrono::microseconds{100}};
+    std::uint64_t sample_mask_{};
+    std::uint64_t notify_count_{};
+#else
     std::set<Observer*> observers_;
+#endif
+    std::vector<std::pair<SubscriptionId, Subscriber>> subscribers_;
+    SubscriptionId next_subscription_id_{};
 
 public:
-    Subject() : state_(0)
+    // storage for subscribers is reserved up front - subscribe() never allocates
+    explicit Subject(std::size_t subscriber_capacity = default_subscriber_capacity) : state_(0)
     {
+        subscribers_.reserve(subscriber_capacity);
     }
 
     void register_observer(Observer* observer)
     {
+#ifdef ENABLE_NOTIFY_INSTRUMENTATION
+        observers_.try_emplace(observer);
+#else
         observers_.insert(observer);
+#endif
     }
 
     void unregister_observer(Observer* observer)
@@ -33,21 +72,100 @@ public:
         observers_.erase(observer);
     }
 
+    // callables are stored inline in the reserved store - throws std::length_error when it is full
+    SubscriptionId subscribe(Subscriber subscriber)
+    {
+        if (subscribers_.size() == subscribers_.capacity())
+            throw std::length_error("Subject - subscriber capacity exceeded");
+
+        subscribers_.emplace_back(++next_subscription_id_, std::move(subscriber));
+        return next_subscription_id_;
+    }
+
+    void unsubscribe(SubscriptionId id)
+    {
+        std::erase_if(subscribers_, [id](const auto& subscriber) { return subscriber.first == id; });
+    }
+
     void set_state(int new_state)
     {
         if (state_ != new_state)
         {
             state_ = new_state;
-            notify("Changed state on: " + std::to_string(state_));
+            notify(StateChanged{state_});
+        }
+    }
+
+#ifdef ENABLE_NOTIFY_INSTRUMENTATION
+    void set_latency_budget(std::chrono::nanoseconds p99_budget)
+    {
+        p99_budget_ = p99_budget;
+    }
+
+    // only every 2^n-th notification is timed - trades histogram resolution for lower overhead
+    void set_latency_sampling(unsigned n)
+    {
+        sample_mask_ = (std::uint64_t{1} << n) - 1;
+    }
+
+    std::vector<ObserverLatency> latency_snapshot() const
+    {
+        std::vector<ObserverLatency> snapshot;
+        snapshot.reserve(observers_.size());
+
+        for (const auto& [observer, histogram] : observers_)
+            snapshot.push_back(ObserverLatency{observer, Instrumentation::stats_of(histogram, p99_budget_)});
+
+        return snapshot;
+    }
+
+    std::vector<const Observer*> slow_observers() const
+    {
+        std::vector<const Observer*> slow;
+
+        for (const auto& [observer, stats] : latency_snapshot())
+        {
+            if (stats.over_budget)
+                slow.push_back(observer);
         }
+
+        return slow;
     }
+#endif
 
 protected:
-    void notify(const std::string& event_args)
+    void notify(const StateChanged& event)
     {
+#ifdef ENABLE_NOTIFY_INSTRUMENTATION
+        if ((notify_count_++ & sample_mask_) == 0)
+        {
+            // end of one call is the start of the next - one timestamp per observer
+            auto start = Instrumentation::ticks();
+
+            for (auto& [observer, histogram] : observers_)
+            {
+                observer->update(event);
+
+                const auto stop = Instrumentation::ticks();
+                histogram.record(stop - start);
+                start = stop;
+            }
+        }
+        else
+        {
+            for (auto& [observer, histogram] : observers_)
+                observer->update(event);
+        }
+#else
         for (Observer* observer : observers_)
         {
-            observer->update(event_args);
+            observer->update(event);
+        }
+#endif
+
+        for (const auto& [id, subscriber] : subscribers_)
+        {
+            subscriber(event);
         }
     }
 };
@@ -55,6 +173,8 @@ protected:
 class ConcreteObserver1 : public Observer
 {
 public:
+    using Observer::update;
+
     virtual void update(const std::string& event)
     {
         std::cout << "ConcreteObserver1: " << event << std::endl;
@@ -64,12 +184,381 @@ public:
 class ConcreteObserver2 : public Observer
 {
 public:
+    using Observer::update;
+
     virtual void update(const std::string& event)
     {
         std::cout << "ConcreteObserver2: " << event << std::endl;
     }
 };
 
+class StateObserver : public Observer
+{
+public:
+    int last_state{};
+
+    void update(const StateChanged& event) override
+    {
+        last_state = event.state;
+    }
+};
+
+class TextObserver : public Observer
+{
+public:
+    std::string last_event;
+
+    using Observer::update;
+
+    void update(const std::string& event) override
+    {
+        last_event = event;
+    }
+};
+
+TEST_CASE("typed events")
+{
+    Subject s;
+
+    StateObserver state_observer;
+    TextObserver text_observer;
+
+    s.register_observer(&state_observer);
+    s.register_observer(&text_observer);
+
+    s.set_state(42);
+
+    SECTION("typed observer gets an event struct")
+    {
+        REQUIRE(state_observer.last_state == 42);
+    }
+
+    SECTION("text observer gets a formatted event through adapter")
+    {
+        REQUIRE(text_observer.last_event == "Changed state on: 42");
+    }
+}
+
+struct StateSum
+{
+    long long sum{};
+
+    void update(const StateChanged& event)
+    {
+        sum += event.state;
+    }
+};
+
+struct StateCounter
+{
+    int count{};
+
+    void update(const StateChanged&)
+    {
+        ++count;
+    }
+};
+
+TEST_CASE("StaticSubject")
+{
+    SECTION("observers held by value")
+    {
+        StaticSubject<StateSum, StateCounter> s;
+
+        s.set_state(1);
+        s.set_state(2);
+        s.set_state(2);
+
+        REQUIRE(s.observer<StateSum>().sum == 3);
+        REQUIRE(s.observer<1>().count == 2);
+    }
+
+    SECTION("observers registered by pointer")
+    {
+        StateObserver state_observer;
+        TextObserver text_observer;
+
+        StaticSubject<StateObserver*, TextObserver*> s;
+        s.register_observer(&state_observer);
+        s.register_observer(&text_observer);
+
+        s.set_state(42);
+
+        REQUIRE(state_observer.last_state == 42);
+        REQUIRE(text_observer.last_event == "Changed state on: 42");
+
+        s.unregister_observer(&text_observer);
+        s.set_state(43);
+
+        REQUIRE(state_observer.last_state == 43);
+        REQUIRE(text_observer.last_event == "Changed state on: 42");
+    }
+}
+
+TEST_CASE("StaticSubject vs Subject - notify", "[.benchmark]")
+{
+    constexpr int notifications = 1'000;
+
+    class SumObserver final : public Observer
+    {
+    public:
+        long long sum{};
+
+        void update(const StateChanged& event) override
+        {
+            sum += event.state;
+        }
+    };
+
+    SumObserver o1, o2;
+    Subject dynamic_subject;
+    dynamic_subject.register_observer(&o1);
+    dynamic_subject.register_observer(&o2);
+
+    StaticSubject<StateSum, StateSum> static_subject;
+
+    BENCHMARK("Subject")
+    {
+        for (int i = 1; i <= notifications; ++i)
+            dynamic_subject.set_state(i);
+
+        return o1.sum + o2.sum;
+    };
+
+    BENCHMARK("StaticSubject")
+    {
+        for (int i = 1; i <= notifications; ++i)
+            static_subject.set_state(i);
+
+        return static_subject.observer<0>().sum + static_subject.observer<1>().sum;
+    };
+}
+
+TEST_CASE("SmallFunction")
+{
+    SECTION("empty")
+    {
+        Helpers::SmallFunction<int(int)> f;
+
+        REQUIRE_FALSE(f);
+        REQUIRE_THROWS_AS(f(1), std::bad_function_call);
+    }
+
+    SECTION("stores move-only callables")
+    {
+        auto ptr = std::make_unique<int>(42);
+        Helpers::SmallFunction<int(int)> f = [ptr = std::move(ptr)](int x) { return *ptr + x; };
+
+        REQUIRE(f(1) == 43);
+
+        auto moved_f = std::move(f);
+        REQUIRE_FALSE(f);
+        REQUIRE(moved_f(2) == 44);
+    }
+
+    SECTION("destroys stored callable")
+    {
+        auto counter = std::make_shared<int>(0);
+
+        {
+            Helpers::SmallFunction<void()> f = [counter] { ++*counter; };
+            f();
+            REQUIRE(counter.use_count() == 2);
+        }
+
+        REQUIRE(counter.use_count() == 1);
+        REQUIRE(*counter == 1);
+    }
+}
+
+TEST_CASE("subscribing callables")
+{
+    Subject s;
+
+    StateObserver state_observer;
+    s.register_observer(&state_observer);
+
+    auto total = std::make_unique<long long>(0);
+    auto id = s.subscribe([&total](const StateChanged& event) { *total += event.state; });
+
+    s.set_state(1);
+    s.set_state(2);
+
+    REQUIRE(*total == 3);
+    REQUIRE(state_observer.last_state == 2);
+
+    s.unsubscribe(id);
+    s.set_state(3);
+
+    REQUIRE(*total == 3);
+    REQUIRE(state_observer.last_state == 3);
+}
+
+TEST_CASE("subscribing callables - registration does not allocate")
+{
+    Subject s{4};
+    long long total = 0;
+    std::vector<Subject::SubscriptionId> ids;
+    ids.reserve(4);
+
+    {
+        AllocationCounting::Scope counting;
+
+        for (int i = 0; i < 4; ++i)
+            ids.push_back(s.subscribe([&total, i](const StateChanged& event) { total += event.state * i; }));
+
+        REQUIRE(AllocationCounting::allocation_count == 0);
+    }
+
+    REQUIRE_THROWS_AS(s.subscribe([](const StateChanged&) { }), std::length_error);
+
+    s.set_state(1);
+    REQUIRE(total == 6);
+
+    SECTION("slot of an unsubscribed callable is reused")
+    {
+        s.unsubscribe(ids.front());
+
+        AllocationCounting::Scope counting;
+        s.subscribe([](const StateChanged&) { });
+
+        REQUIRE(AllocationCounting::allocation_count == 0);
+    }
+}
+
+TEST_CASE("SmallFunction vs std::function vs Observer - invocation", "[.benchmark]")
+{
+    constexpr int calls = 1'000;
+
+    class SumObserver : public Observer
+    {
+    public:
+        long long sum{};
+
+        void update(const StateChanged& event) override
+        {
+            sum += event.state;
+        }
+    };
+
+    long long sum = 0;
+    auto lambda = [&sum](const StateChanged& event) { sum += event.state; };
+
+    Helpers::SmallFunction<void(const StateChanged&)> small_function = lambda;
+    std::function<void(const StateChanged&)> std_function = lambda;
+    std::unique_ptr<Observer> observer = std::make_unique<SumObserver>();
+
+    BENCHMARK("SmallFunction")
+    {
+        for (int i = 0; i < calls; ++i)
+            small_function(StateChanged{i});
+        return sum;
+    };
+
+    BENCHMARK("std::function")
+    {
+        for (int i = 0; i < calls; ++i)
+            std_function(StateChanged{i});
+        return sum;
+    };
+
+    BENCHMARK("Observer")
+    {
+        for (int i = 0; i < calls; ++i)
+            observer->update(StateChanged{i});
+        return static_cast<SumObserver&>(*observer).sum;
+    };
+}
+
+TEST_CASE("LatencyHistogram")
+{
+    Instrumentation::LatencyHistogram histogram;
+
+    REQUIRE(histogram.percentile(99.0) == 0);
+
+    for (int i = 0; i < 99; ++i)
+        histogram.record(10);
+    histogram.record(5000);
+
+    REQUIRE(histogram.count() == 100);
+    REQUIRE(histogram.max() == 5000);
+    REQUIRE(histogram.buckets()[4] == 99); // [8, 16)
+
+    SECTION("percentile is an upper bound of a bucket")
+    {
+        REQUIRE(histogram.percentile(50.0) == 15);
+        REQUIRE(histogram.percentile(99.0) == 15);
+        REQUIRE(histogram.percentile(100.0) == 5000);
+    }
+}
+
+TEST_CASE("noexcept audit - observers")
+{
+    static_assert(Helpers::SpecialMembers<StateChanged>::copy_constructor == Helpers::MemberGuarantee::trivial);
+    static_assert(Helpers::SpecialMembers<Instrumentation::LatencyHistogram>::copy_constructor == Helpers::MemberGuarantee::trivial);
+    static_assert(Helpers::SpecialMembers<Instrumentation::LatencyStats>::copy_constructor == Helpers::MemberGuarantee::trivial);
+
+    static_assert(Helpers::assert_nothrow_movable<Helpers::SmallFunction<void(const StateChanged&)>>());
+    static_assert(Helpers::assert_nothrow_movable<StaticSubject<StateSum, StateCounter>>());
+}
+
+#ifdef ENABLE_NOTIFY_INSTRUMENTATION
+TEST_CASE("notify instrumentation")
+{
+    class BusyObserver : public Observer
+    {
+        std::chrono::microseconds delay_;
+
+    public:
+        explicit BusyObserver(std::chrono::microseconds delay)
+            : delay_{delay}
+        { }
+
+        void update(const StateChanged&) override
+        {
+            auto until = std::chrono::steady_clock::now() + delay_;
+            while (std::chrono::steady_clock::now() < until)
+            { } // busy work
+        }
+    };
+
+    using namespace std::chrono_literals;
+
+    Subject s;
+    s.set_latency_budget(500us);
+
+    StateObserver fast_observer;
+    BusyObserver slow_observer{2ms};
+    s.register_observer(&fast_observer);
+    s.register_observer(&slow_observer);
+
+    for (int state = 1; state <= 10; ++state)
+        s.set_state(state);
+
+    auto snapshot = s.latency_snapshot();
+    REQUIRE(snapshot.size() == 2);
+
+    for (const auto& [observer, stats] : snapshot)
+    {
+        REQUIRE(stats.count == 10);
+        REQUIRE(stats.p50 <= stats.p99);
+        REQUIRE(stats.p99 <= stats.max);
+    }
+
+    REQUIRE(s.slow_observers() == std::vector<const Observer*>{&slow_observer});
+
+    SECTION("sampling")
+    {
+        s.set_latency_sampling(2); // every 4th notification
+
+        for (int state = 11; state <= 18; ++state)
+            s.set_state(state);
+
+        REQUIRE(s.latency_snapshot()[0].stats.count == 12);
+    }
+}
+#endif
+
 TEST_CASE("using observer pattern")
 {
     // using namespace std;
@@ -1,3 +1,7 @@
+#include "gadget_table.hpp"
+#include "noexcept_audit.hpp"
+#include "slot_map.hpp"
+
 #include <exception>
 #include <iostream>
 #include <memory>
@@ -18,6 +22,9 @@ public:
     Gadget(const Gadget&) = delete;
     Gadget& operator=(const Gadget&) = delete;
 
+    Gadget(Gadget&&) noexcept = default;
+    Gadget& operator=(Gadget&&) noexcept = default;
+
     ~Gadget()
     {
         std::cout << "Destroying ~Gadget(" << id_ << ")\n";
@@ -48,6 +55,10 @@ private:
     int id_;
 };
 
+// move-only types - vectors of them move items on reallocation
+static_assert(Helpers::assert_nothrow_movable<Gadget>());
+static_assert(Helpers::assert_nothrow_movable<Helpers::GadgetTable>());
+
 namespace LegacyCode
 {
     Gadget* create_many_gadgets(unsigned int size)
@@ -77,37 +88,47 @@ Gadget* create_gadget(int arg)
     return new Gadget(arg);
 }
 
+using GadgetStore = Helpers::SlotMap<Gadget>;
+using GadgetHandle = GadgetStore::Handle;
+
 class Player
 {
-    Gadget* gadget_;
+    GadgetStore& gadgets_;
+    GadgetHandle gadget_;
     std::ostream* logger_;
 
-    Player(const Player&);
-    Player& operator=(const Player&);
-
 public:
-    Player(Gadget* g, std::ostream* logger = NULL)
-        : gadget_(g)
+    Player(GadgetStore& gadgets, GadgetHandle g, std::ostream* logger = nullptr)
+        : gadgets_(gadgets)
+        , gadget_(g)
         , logger_(logger)
     {
-        if (g == NULL)
+        if (!gadgets_.contains(g))
             throw std::invalid_argument("Gadget can not be null");
     }
 
+    Player(const Player&) = delete;
+    Player& operator=(const Player&) = delete;
+
     ~Player()
     {
-        if (logger_)
-            *logger_ << "Destroing a gadget: " << gadget_->id() << std::endl;
+        if (logger_ && gadgets_.contains(gadget_))
+            *logger_ << "Destroing a gadget: " << gadgets_[gadget_].id() << std::endl;
 
-        delete gadget_;
+        gadgets_.erase(gadget_);
     }
 
     void play()
     {
+        Gadget* gadget = gadgets_.get(gadget_);
+
+        if (!gadget)
+            throw std::logic_error("Gadget has been destroyed");
+
         if (logger_)
-            *logger_ << "Player is using a gadget: " << gadget_->id() << std::endl;
+            *logger_ << "Player is using a gadget: " << gadget->id() << std::endl;
 
-        gadget_->use();
+        gadget->use();
     }
 };
 
@@ -124,46 +145,39 @@ void unsafe1() // TODO: modernize using smart pointers
     delete ptr_gdgt;
 }
 
-void unsafe2() // TODO: modernize using smart pointers
+void unsafe2()
 {
     int size = 10;
 
-    Gadget* buffer = LegacyCode::create_many_gadgets(size);
+    Helpers::GadgetTable gadgets(size); // one allocation instead of size gadgets
 
     for (int i = 0; i < size; ++i)
-        buffer[0].unsafe();
-
-    delete[] buffer;
+        gadgets[0].unsafe();
 }
 
-void unsafe3() // TODO: modernize using smart pointers
+void unsafe3()
 {
-    vector<Gadget*> my_gadgets;
+    GadgetStore my_gadgets;
 
-    my_gadgets.push_back(create_gadget(87));
-    my_gadgets.push_back(create_gadget(12));
-    my_gadgets.push_back(new Gadget(98));
+    std::vector<GadgetHandle> handles = {my_gadgets.emplace(87), my_gadgets.emplace(12), my_gadgets.emplace(98)};
 
     int value_generator = 0;
-    for (vector<Gadget*>::iterator it = my_gadgets.begin(); it != my_gadgets.end(); ++it)
+    for (Gadget& g : my_gadgets)
     {
-        cout << "Gadget's old id: " << (*it)->id() << endl;
-        reset_value(**it, ++value_generator);
+        cout << "Gadget's old id: " << g.id() << endl;
+        reset_value(g, ++value_generator);
     }
 
-    delete my_gadgets[0];
-    my_gadgets[0] = NULL;
+    my_gadgets.erase(handles[0]);
 
-    Player p(my_gadgets.back());
-    my_gadgets.back() = NULL;
-    p.play();
+    if (!my_gadgets.contains(handles[0]))
+        cout << "Gadget #0 has been destroyed - handle is stale" << endl;
 
-    my_gadgets[1]->unsafe();
+    Player p(my_gadgets, handles.back());
+    p.play();
 
-    // cleanup
-    for (vector<Gadget*>::iterator it = my_gadgets.begin(); it != my_gadgets.end(); ++it)
-        delete *it;
-}
+    my_gadgets[handles[1]].unsafe();
+} // cleanup - gadgets are owned by my_gadgets
 
 int main() try
 {
@@ -0,0 +1,252 @@
+#ifndef CONCURRENT_STACK_HPP
+#define CONCURRENT_STACK_HPP
+
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <optional>
+#include <utility>
+
+// Lock-free LIFO stack (Treiber stack)
+//  - head is a tagged pointer: [ tag (16 bits) | address (48 bits) ] - the tag changes on every update,
+//    so a node popped and pushed back between a load and a CAS does not fool the CAS (ABA)
+//    - the tag wraps after 65536 updates: ABA is still possible for a thread stalled between its load & CAS
+//      for exactly a multiple of 65536 updates ending with the same node on top - accepted as negligible
+//  - nodes are recycled through a per-thread cache backed by a global lock-free free list
+//    and are not returned to the system while stacks are in use, so reading next of a node popped by another
+//    thread is safe - pooled nodes are freed at exit (stacks of T with static storage duration are not supported)
+template <typename T>
+class ConcurrentStack
+{
+    struct Node
+    {
+        std::atomic<Node*> next{};
+        alignas(T) std::byte storage[sizeof(T)];
+
+        T* value()
+        {
+            return std::launder(reinterpret_cast<T*>(storage));
+        }
+    };
+
+    static_assert(sizeof(void*) == 8, "Tagged pointers require 64-bit addresses");
+
+    static constexpr int address_bits = 48;
+    static constexpr std::uint64_t address_mask = (std::uint64_t{1} << address_bits) - 1;
+
+    static Node* address_of(std::uint64_t tagged)
+    {
+        return reinterpret_cast<Node*>(tagged & address_mask);
+    }
+
+    static std::uint64_t retag(std::uint64_t tagged, Node* node)
+    {
+        const auto address = reinterpret_cast<std::uint64_t>(node);
+        assert((address & ~address_mask) == 0);
+
+        return (((tagged >> address_bits) + 1) << address_bits) | address;
+    }
+
+    class NodeList
+    {
+        std::atomic<std::uint64_t> head_{};
+
+    public:
+        void push(Node* node)
+        {
+            auto old_head = head_.load(std::memory_order_relaxed);
+
+            do
+            {
+                node->next.store(address_of(old_head), std::memory_order_relaxed);
+            } while (!head_.compare_exchange_weak(old_head, retag(old_head, node), std::memory_order_release, std::memory_order_relaxed));
+        }
+
+        Node* pop()
+        {
+            auto old_head = head_.load(std::memory_order_acquire);
+
+            while (Node* node = address_of(old_head))
+            {
+                Node* next = node->next.load(std::memory_order_relaxed);
+
+                if (head_.compare_exchange_weak(old_head, retag(old_head, next), std::memory_order_acquire, std::memory_order_acquire))
+                    return node;
+            }
+
+            return nullptr;
+        }
+
+        bool empty() const
+        {
+            return address_of(head_.load(std::memory_order_acquire)) == nullptr;
+        }
+    };
+
+    // shared by all stacks of the same T
+    class NodePool
+    {
+        static constexpr std::size_t local_cache_limit = 256;
+
+        // destroyed after thread-local caches of the main thread (they push their nodes here)
+        struct GlobalFreeList : NodeList
+        {
+            ~GlobalFreeList()
+            {
+                while (Node* node = this->pop())
+                    delete node;
+            }
+        };
+
+        static NodeList& global_free_list()
+        {
+            static GlobalFreeList free_list;
+            return free_list;
+        }
+
+        struct LocalCache
+        {
+            Node* head{};
+            std::size_t count{};
+
+            ~LocalCache()
+            {
+                while (head)
+                    global_free_list().push(std::exchange(head, head->next.load(std::memory_order_relaxed)));
+            }
+        };
+
+        static LocalCache& local_cache()
+        {
+            thread_local LocalCache cache;
+            return cache;
+        }
+
+    public:
+        static Node* acquire()
+        {
+            LocalCache& cache = local_cache();
+
+            if (cache.head)
+            {
+                --cache.count;
+                return std::exchange(cache.head, cache.head->next.load(std::memory_order_relaxed));
+            }
+
+            if (Node* node = global_free_list().pop())
+                return node;
+
+            return new Node;
+        }
+
+        static void release(Node* node)
+        {
+            LocalCache& cache = local_cache();
+
+            if (cache.count < local_cache_limit)
+            {
+                node->next.store(cache.head, std::memory_order_relaxed);
+                cache.head = node;
+                ++cache.count;
+            }
+            else
+            {
+                global_free_list().push(node);
+            }
+        }
+    };
+
+    // destroys the value of a popped node & returns the node to the pool - also when moving the value out throws
+    struct PoppedNode
+    {
+        Node* node;
+
+        ~PoppedNode()
+        {
+            std::destroy_at(node->value());
+            NodePool::release(node);
+        }
+    };
+
+    NodeList items_;
+
+public:
+    ConcurrentStack() = default;
+
+    ConcurrentStack(const ConcurrentStack&) = delete;
+    ConcurrentStack& operator=(const ConcurrentStack&) = delete;
+
+    ~ConcurrentStack()
+    {
+        while (Node* node = items_.pop())
+        {
+            std::destroy_at(node->value());
+            NodePool::release(node);
+        }
+    }
+
+    template <typename... TArgs>
+    void emplace(TArgs&&... args)
+    {
+        Node* node = NodePool::acquire();
+
+        try
+        {
+            std::construct_at(node->value(), std::forward<TArgs>(args)...);
+        }
+        catch (...)
+        {
+            NodePool::release(node);
+            throw;
+        }
+
+        items_.push(node);
+    }
+
+    void push(const T& item)
+    {
+        emplace(item);
+    }
+
+    void push(T&& item)
+    {
+        emplace(std::move(item));
+    }
+
+    // if moving the item out throws, the item is lost (basic exception guarantee)
+    std::optional<T> pop()
+    {
+        Node* node = items_.pop();
+
+        if (!node)
+            return std::nullopt;
+
+        PoppedNode popped{node};
+
+        return std::optional<T>{std::move(*node->value())};
+    }
+
+    bool try_pop(T& item)
+    {
+        Node* node = items_.pop();
+
+        if (!node)
+            return false;
+
+        PoppedNode popped{node};
+        item = std::move(*node->value());
+
+        return true;
+    }
+
+    // snapshot - may be outdated as soon as it returns
+    bool empty() const
+    {
+        return items_.empty();
+    }
+};
+
+#endif
@@ -0,0 +1,213 @@
+#ifndef SMALL_STACK_HPP
+#define SMALL_STACK_HPP
+
+#include "relocation.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+// Stack with inline storage for N elements
+//  - no allocation until more than N elements are pushed - then items spill to a heap buffer (growth x2)
+//  - moving an inline stack relocates its elements, moving a spilled stack steals the heap buffer
+template <typename T, std::size_t N = 16>
+class SmallStack
+{
+    static_assert(N > 0);
+
+    T* data_;
+    std::size_t size_{};
+    std::size_t capacity_{N};
+    alignas(T) std::byte inline_storage_[sizeof(T) * N];
+
+    T* inline_data()
+    {
+        return std::launder(reinterpret_cast<T*>(inline_storage_));
+    }
+
+    bool is_inline() const
+    {
+        return data_ == reinterpret_cast<const T*>(inline_storage_);
+    }
+
+    static T* allocate(std::size_t capacity)
+    {
+        return static_cast<T*>(::operator new(capacity * sizeof(T), std::align_val_t{alignof(T)}));
+    }
+
+    static void deallocate(T* data)
+    {
+        ::operator delete(data, std::align_val_t{alignof(T)});
+    }
+
+    void grow()
+    {
+        const std::size_t new_capacity = 2 * capacity_;
+        T* new_data = allocate(new_capacity);
+
+        Helpers::relocate(data_, data_ + size_, new_data); // memcpy for trivially relocatable items, nothrow moves otherwise
+        release_heap();
+
+        data_ = new_data;
+        capacity_ = new_capacity;
+    }
+
+    void release_heap()
+    {
+        if (!is_inline())
+            deallocate(data_);
+    }
+
+    // leaves source empty & inline
+    void steal(SmallStack& source) noexcept
+    {
+        if (source.is_inline())
+        {
+            Helpers::relocate(source.data_, source.data_ + source.size_, data_);
+        }
+        else
+        {
+            data_ = std::exchange(source.data_, source.inline_data());
+            capacity_ = std::exchange(source.capacity_, N);
+        }
+
+        size_ = std::exchange(source.size_, 0);
+    }
+
+public:
+    using value_type = T;
+    using size_type = std::size_t;
+    using reference = T&;
+    using const_reference = const T&;
+
+    static_assert(std::is_nothrow_move_constructible_v<T>, "SmallStack requires nothrow move constructible items");
+
+    SmallStack()
+        : data_{inline_data()}
+    { }
+
+    SmallStack(const SmallStack& source)
+        : SmallStack()
+    {
+        for (std::size_t i = 0; i < source.size_; ++i)
+            push(source.data_[i]);
+    }
+
+    SmallStack& operator=(const SmallStack& source)
+    {
+        if (this != &source)
+        {
+            SmallStack temp(source);
+            *this = std::move(temp);
+        }
+
+        return *this;
+    }
+
+    SmallStack(SmallStack&& source) noexcept
+        : SmallStack()
+    {
+        steal(source);
+    }
+
+    SmallStack& operator=(SmallStack&& source) noexcept
+    {
+        if (this != &source)
+        {
+            clear();
+            release_heap();
+            data_ = inline_data();
+            capacity_ = N;
+
+            steal(source);
+        }
+
+        return *this;
+    }
+
+    ~SmallStack()
+    {
+        clear();
+        release_heap();
+    }
+
+    bool empty() const
+    {
+        return size_ == 0;
+    }
+
+    size_type size() const
+    {
+        return size_;
+    }
+
+    size_type capacity() const
+    {
+        return capacity_;
+    }
+
+    // true until the first spill to the heap
+    bool uses_inline_storage() const
+    {
+        return is_inline();
+    }
+
+    template <typename... TArgs>
+    reference emplace(TArgs&&... args)
+    {
+        if (size_ == capacity_) // args may refer to an item of this stack - construct before buffer is moved
+        {
+            T item(std::forward<TArgs>(args)...);
+            grow();
+
+            return *std::construct_at(data_ + size_++, std::move(item));
+        }
+
+        T* item = std::construct_at(data_ + size_, std::forward<TArgs>(args)...);
+        ++size_;
+
+        return *item;
+    }
+
+    void push(const T& item)
+    {
+        emplace(item);
+    }
+
+    void push(T&& item)
+    {
+        emplace(std::move(item));
+    }
+
+    reference top()
+    {
+        assert(!empty());
+        return data_[size_ - 1];
+    }
+
+    const_reference top() const
+    {
+        assert(!empty());
+        return data_[size_ - 1];
+    }
+
+    void pop()
+    {
+        assert(!empty());
+
+        std::destroy_at(data_ + size_ - 1);
+        --size_;
+    }
+
+    void clear()
+    {
+        std::destroy(data_, data_ + size_);
+        size_ = 0;
+    }
+};
+
+#endif
@@ -0,0 +1,205 @@
+#ifndef STACK_HPP
+#define STACK_HPP
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <utility>
+#include <vector>
+
+// Stack stored in fixed-size chunks linked together
+//  - push() never moves existing elements - references to them stay valid
+//  - worst-case push is one chunk allocation (no reallocation of the whole buffer)
+//  - one emptied chunk is kept as a spare, so push/pop at a chunk boundary does not thrash the allocator
+template <typename T, std::size_t ChunkSize = std::max<std::size_t>(16, 4096 / sizeof(T))>
+class Stack
+{
+    static_assert(ChunkSize > 0);
+
+    struct Chunk
+    {
+        Chunk* prev;
+        alignas(T) std::byte storage[sizeof(T) * ChunkSize];
+
+        T* data()
+        {
+            return std::launder(reinterpret_cast<T*>(storage));
+        }
+    };
+
+    Chunk* top_chunk_{};
+    std::size_t top_count_{}; // number of elements in top_chunk_
+    std::size_t size_{};
+    Chunk* spare_{};
+
+    void release_chunks() noexcept
+    {
+        while (!empty())
+            pop();
+
+        delete top_chunk_;
+        delete spare_;
+        top_chunk_ = nullptr;
+        spare_ = nullptr;
+    }
+
+public:
+    using value_type = T;
+    using size_type = std::size_t;
+    using reference = T&;
+    using const_reference = const T&;
+
+    Stack() = default;
+
+    Stack(const Stack& source)
+        : Stack()
+    {
+        std::vector<Chunk*> chunks; // bottom chunk last
+        for (Chunk* chunk = source.top_chunk_; chunk; chunk = chunk->prev)
+            chunks.push_back(chunk);
+
+        for (auto it = chunks.rbegin(); it != chunks.rend(); ++it)
+        {
+            const std::size_t count = (*it == source.top_chunk_) ? source.top_count_ : ChunkSize;
+            for (std::size_t i = 0; i < count; ++i)
+                push((*it)->data()[i]);
+        }
+    }
+
+    Stack& operator=(const Stack& source)
+    {
+        if (this != &source)
+        {
+            Stack temp(source);
+            swap(temp);
+        }
+
+        return *this;
+    }
+
+    Stack(Stack&& source) noexcept
+        : top_chunk_{std::exchange(source.top_chunk_, nullptr)}
+        , top_count_{std::exchange(source.top_count_, 0)}
+        , size_{std::exchange(source.size_, 0)}
+        , spare_{std::exchange(source.spare_, nullptr)}
+    { }
+
+    Stack& operator=(Stack&& source) noexcept
+    {
+        if (this != &source)
+        {
+            Stack temp(std::move(source));
+            swap(temp);
+        }
+
+        return *this;
+    }
+
+    ~Stack()
+    {
+        release_chunks();
+    }
+
+    void swap(Stack& other) noexcept
+    {
+        std::swap(top_chunk_, other.top_chunk_);
+        std::swap(top_count_, other.top_count_);
+        std::swap(size_, other.size_);
+        std::swap(spare_, other.spare_);
+    }
+
+    bool empty() const
+    {
+        return size_ == 0;
+    }
+
+    size_type size() const
+    {
+        return size_;
+    }
+
+    // if a constructor of T throws, the stack is left unchanged (a new chunk becomes the spare)
+    template <typename... TArgs>
+    reference emplace(TArgs&&... args)
+    {
+        if (top_chunk_ && top_count_ < ChunkSize)
+        {
+            T* item = std::construct_at(top_chunk_->data() + top_count_, std::forward<TArgs>(args)...);
+            ++top_count_;
+            ++size_;
+
+            return *item;
+        }
+
+        Chunk* chunk = spare_ ? std::exchange(spare_, nullptr) : new Chunk;
+
+        T* item;
+        try
+        {
+            item = std::construct_at(chunk->data(), std::forward<TArgs>(args)...);
+        }
+        catch (...)
+        {
+            spare_ = chunk;
+            throw;
+        }
+
+        // linked only after the item is constructed
+        chunk->prev = top_chunk_;
+        top_chunk_ = chunk;
+        top_count_ = 1;
+        ++size_;
+
+        return *item;
+    }
+
+    void push(const T& item)
+    {
+        emplace(item);
+    }
+
+    void push(T&& item)
+    {
+        emplace(std::move(item));
+    }
+
+    reference top()
+    {
+        assert(!empty());
+        return top_chunk_->data()[top_count_ - 1];
+    }
+
+    const_reference top() const
+    {
+        assert(!empty());
+        return top_chunk_->data()[top_count_ - 1];
+    }
+
+    void pop()
+    {
+        assert(!empty());
+
+        std::destroy_at(top_chunk_->data() + top_count_ - 1);
+        --top_count_;
+        --size_;
+
+        if (top_count_ == 0 && top_chunk_->prev) // keep at least one chunk in use
+        {
+            Chunk* emptied = std::exchange(top_chunk_, top_chunk_->prev);
+            top_count_ = ChunkSize;
+
+            delete spare_;
+            spare_ = emptied;
+        }
+    }
+
+    // releases the spare chunk
+    void shrink_to_fit()
+    {
+        delete std::exchange(spare_, nullptr);
+    }
+};
+
+#endif
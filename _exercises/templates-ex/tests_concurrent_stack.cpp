@@ -0,0 +1,233 @@
+#include "concurrent_stack.hpp"
+#include "noexcept_audit.hpp"
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <stack>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace std::literals;
+
+TEST_CASE("ConcurrentStack - not movable", "[concurrent_stack]")
+{
+    using Members = Helpers::SpecialMembers<ConcurrentStack<std::string>>;
+
+    static_assert(Members::copy_constructor == Helpers::MemberGuarantee::deleted);
+    static_assert(Members::move_constructor == Helpers::MemberGuarantee::deleted);
+    static_assert(Members::destructor == Helpers::MemberGuarantee::nothrow);
+}
+
+TEST_CASE("ConcurrentStack - single thread", "[concurrent_stack]")
+{
+    ConcurrentStack<int> s;
+
+    REQUIRE(s.empty());
+    REQUIRE_FALSE(s.pop().has_value());
+
+    s.push(1);
+    s.push(4);
+
+    REQUIRE_FALSE(s.empty());
+
+    SECTION("LIFO order")
+    {
+        REQUIRE(s.pop() == 4);
+        REQUIRE(s.pop() == 1);
+        REQUIRE(s.empty());
+    }
+
+    SECTION("try_pop")
+    {
+        int item{};
+
+        REQUIRE(s.try_pop(item));
+        REQUIRE(item == 4);
+    }
+}
+
+TEST_CASE("ConcurrentStack - stores move-only objects", "[concurrent_stack,move]")
+{
+    ConcurrentStack<std::unique_ptr<std::string>> s;
+
+    s.push(std::make_unique<std::string>("test1"));
+    s.emplace(std::make_unique<std::string>("test2"));
+
+    REQUIRE(**s.pop() == "test2"s);
+    REQUIRE(**s.pop() == "test1"s);
+
+    s.push(std::make_unique<std::string>("left on a stack")); // released by destructor
+}
+
+namespace
+{
+    struct ThrowingMove
+    {
+        int value;
+        bool throws_on_move = false;
+
+        ThrowingMove(int v, bool throws)
+            : value{v}
+            , throws_on_move{throws}
+        { }
+
+        ThrowingMove(const ThrowingMove&) = default;
+        ThrowingMove& operator=(const ThrowingMove&) = default;
+
+        ThrowingMove(ThrowingMove&& source)
+            : value{source.value}
+            , throws_on_move{source.throws_on_move}
+        {
+            if (throws_on_move)
+                throw std::runtime_error("move failed");
+        }
+
+        ThrowingMove& operator=(ThrowingMove&& source)
+        {
+            if (source.throws_on_move)
+                throw std::runtime_error("move failed");
+
+            value = source.value;
+            return *this;
+        }
+    };
+} // namespace
+
+TEST_CASE("ConcurrentStack - throwing move of a popped item", "[concurrent_stack]")
+{
+    ConcurrentStack<ThrowingMove> s;
+    s.push(ThrowingMove{1, false});
+
+    SECTION("pop")
+    {
+        s.emplace(2, true);
+        REQUIRE_THROWS_AS(s.pop(), std::runtime_error);
+    }
+
+    SECTION("try_pop")
+    {
+        s.emplace(2, true);
+
+        ThrowingMove item{0, false};
+        REQUIRE_THROWS_AS(s.try_pop(item), std::runtime_error);
+    }
+
+    // the failed item is dropped, its node reused
+    s.emplace(3, false);
+    REQUIRE(s.pop()->value == 3);
+    REQUIRE(s.pop()->value == 1);
+    REQUIRE(s.empty());
+}
+
+TEST_CASE("ConcurrentStack - concurrent push & pop", "[concurrent_stack]")
+{
+    constexpr int thread_count = 4;
+    constexpr int items_per_thread = 10'000;
+
+    ConcurrentStack<int> s;
+    std::atomic<long long> popped_sum{};
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < thread_count; ++t)
+    {
+        threads.emplace_back([&, t] {
+            long long sum = 0;
+
+            for (int i = 0; i < items_per_thread; ++i)
+            {
+                s.push(t * items_per_thread + i);
+
+                if (auto item = s.pop())
+                    sum += *item;
+            }
+
+            popped_sum += sum;
+        });
+    }
+
+    for (auto& t : threads)
+        t.join();
+
+    long long left_sum = 0;
+    while (auto item = s.pop())
+        left_sum += *item;
+
+    const long long n = thread_count * items_per_thread;
+    REQUIRE(popped_sum + left_sum == n * (n - 1) / 2);
+}
+
+namespace Benchmark
+{
+    template <typename T>
+    class LockedStack
+    {
+        std::stack<T, std::vector<T>> items_;
+        std::mutex mtx_;
+
+    public:
+        void push(T item)
+        {
+            std::lock_guard lk{mtx_};
+            items_.push(std::move(item));
+        }
+
+        std::optional<T> pop()
+        {
+            std::lock_guard lk{mtx_};
+
+            if (items_.empty())
+                return std::nullopt;
+
+            std::optional<T> item{std::move(items_.top())};
+            items_.pop();
+
+            return item;
+        }
+    };
+
+    template <typename TStack>
+    void push_pop(TStack& s, int thread_count, int operations)
+    {
+        std::vector<std::thread> threads;
+        for (int t = 0; t < thread_count; ++t)
+        {
+            threads.emplace_back([&] {
+                for (int i = 0; i < operations; ++i)
+                {
+                    s.push(i);
+                    s.pop();
+                }
+            });
+        }
+
+        for (auto& t : threads)
+            t.join();
+    }
+} // namespace Benchmark
+
+TEST_CASE("ConcurrentStack vs mutex-protected stack - throughput", "[.benchmark]")
+{
+    constexpr int operations = 100'000;
+
+    for (int thread_count : {1, 2, 4, 8, 16, 32})
+    {
+        ConcurrentStack<int> lock_free_stack;
+        Benchmark::LockedStack<int> locked_stack;
+
+        BENCHMARK("ConcurrentStack - threads: " + std::to_string(thread_count))
+        {
+            Benchmark::push_pop(lock_free_stack, thread_count, operations);
+        };
+
+        BENCHMARK("LockedStack - threads: " + std::to_string(thread_count))
+        {
+            Benchmark::push_pop(locked_stack, thread_count, operations);
+        };
+    }
+}
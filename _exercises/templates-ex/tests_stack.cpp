@@ -1,167 +1,525 @@
+#include "noexcept_audit.hpp"
+#include "small_stack.hpp"
+#include "stack.hpp"
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_template_test_macros.hpp>
 #include <catch2/catch_test_macros.hpp>
 #include <algorithm>
 #include <array>
+#include <chrono>
+#include <deque>
+#include <iostream>
 #include <memory>
+#include <stack>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// stack implementations sharing the spec below - StackOf<T> is a stack of T
+struct ChunkedStack
+{
+    template <typename T>
+    using StackOf = Stack<T>;
+};
+
+template <std::size_t N>
+struct InlineStack
+{
+    template <typename T>
+    using StackOf = SmallStack<T, N>;
+};
+
+#define STACK_IMPLEMENTATIONS ChunkedStack, InlineStack<16>, InlineStack<2>
+
+TEMPLATE_TEST_CASE("After construction", "[stack,constructors]", STACK_IMPLEMENTATIONS)
+{
+    typename TestType::template StackOf<int> s;
+
+    SECTION("is empty")
+    {
+        REQUIRE(s.empty());
+    }
+
+    SECTION("size is zero")
+    {
+        REQUIRE(s.size() == 0);
+    }
+}
+
+TEMPLATE_TEST_CASE("Pushing an item", "[stack,push]", STACK_IMPLEMENTATIONS)
+{
+    typename TestType::template StackOf<int> s;
+
+    SECTION("is no longer empty")
+    {
+        s.push(1);
+
+        REQUIRE(!s.empty());
+    }
+
+    SECTION("size is increased")
+    {
+        auto size_before = s.size();
+
+        s.push(1);
+
+        REQUIRE(s.size() - size_before == 1);
+    }
+
+    SECTION("recently pushed item is on a top")
+    {
+        s.push(4);
+
+        REQUIRE(s.top() == 4);
+    }
+}
 
-// TEST_CASE("After construction", "[stack,constructors]")
-// {
-//     Stack<int> s;
+template <typename TStack>
+std::vector<typename TStack::value_type> pop_all(TStack& s)
+{
+    std::vector<typename TStack::value_type> values(s.size());
 
-//     SECTION("is empty")
-//     {
-//         REQUIRE(s.empty());
-//     }
+    for (auto& item : values)
+    {
+        item = std::move(s.top());
+        s.pop();
+    }
 
-//     SECTION("size is zero")
-//     {
-//         REQUIRE(s.size() == 0);
-//     }
-// }
+    return values;
+}
 
-// TEST_CASE("Pushing an item", "[stack,push]")
-// {
-//     Stack<int> s;
+TEMPLATE_TEST_CASE("Popping an item", "[stack,pop]", STACK_IMPLEMENTATIONS)
+{
+    typename TestType::template StackOf<int> s;
 
-//     SECTION("is no longer empty")
-//     {
-//         s.push(1);
+    s.push(1);
+    s.push(4);
 
-//         REQUIRE(!s.empty());
-//     }
+    int item;
 
-//     SECTION("size is increased")
-//     {
-//         auto size_before = s.size();
+    SECTION("assignes an item from a top to an argument passed by ref")
+    {
+        item = s.top();
+        s.pop();
 
-//         s.push(1);
+        REQUIRE(item == 4);
+    }
 
-//         REQUIRE(s.size() - size_before == 1);
-//     }
+    SECTION("size is decreased")
+    {
+        size_t size_before = s.size();
 
-//     SECTION("recently pushed item is on a top")
-//     {
-//         s.push(4);
+        item = s.top();
+        s.pop();
 
-//         REQUIRE(s.top() == 4);
-//     }
-// }
 
-// template <typename T>
-// std::vector<T> pop_all(Stack<T>& s)
-// {
-//     std::vector<T> values(s.size());
+        REQUIRE(size_before - s.size() == 1);
+    }
 
-//     for (auto& item : values)
-//     {
-//         item = std::move(s.top());
-//         s.pop();
-//     }
+    SECTION("LIFO order")
+    {
+        int a, b;
 
-//     return values;
-// }
+        a = s.top();
+        s.pop();
 
-// TEST_CASE("Popping an item", "[stack,pop]")
-// {
-//     Stack<int> s;
+        b = s.top();
+        s.pop();
 
-//     s.push(1);
-//     s.push(4);
 
-//     int item;
+        REQUIRE(a == 4);
+        REQUIRE(b == 1);
+    }
+}
 
-//     SECTION("assignes an item from a top to an argument passed by ref")
-//     {
-//         item = s.top();
-//         s.pop();
+TEMPLATE_TEST_CASE("Move semantics", "[stack,push,pop,move]", STACK_IMPLEMENTATIONS)
+{
+    using namespace std::literals;
 
-//         REQUIRE(item == 4);
-//     }
+    SECTION("stores move-only objects")
+    {
+        auto txt1 = std::make_unique<std::string>("test1");
 
-//     SECTION("size is decreased")
-//     {
-//         size_t size_before = s.size();
+        typename TestType::template StackOf<std::unique_ptr<std::string>> s;
 
-//         item = s.top();
-//         s.pop();
+        s.push(move(txt1));
+        s.push(std::make_unique<std::string>("test2"));
 
+        std::unique_ptr<std::string> value;
 
-//         REQUIRE(size_before - s.size() == 1);
-//     }
+        value = std::move(s.top());
+        s.pop();
+        REQUIRE(*value == "test2"s);
 
-//     SECTION("LIFO order")
-//     {
-//         int a, b;
+        value = std::move(s.top());
+        s.pop();
+        REQUIRE(*value == "test1"s);
+    }
 
-//         a = s.top();
-//         s.pop();
+    SECTION("move constructor", "[stack,move]")
+    {
+        typename TestType::template StackOf<std::unique_ptr<std::string>> s;
 
-//         b = s.top();
-//         s.pop();
+        s.push(std::make_unique<std::string>("txt1"));
+        s.push(std::make_unique<std::string>("txt2"));
+        s.push(std::make_unique<std::string>("txt3"));
 
+        auto moved_s = std::move(s);
 
-//         REQUIRE(a == 4);
-//         REQUIRE(b == 1);
-//     }
-// }
+        auto values = pop_all(moved_s);
 
-// TEST_CASE("Move semantics", "[stack,push,pop,move]")
-// {
-//     using namespace std::literals;
+        auto expected = {"txt3", "txt2", "txt1"};
+        REQUIRE(std::equal(values.begin(), values.end(), expected.begin(), [](const auto& a, const auto& b) { return *a == b; }));
+    }
 
-//     SECTION("stores move-only objects")
-//     {
-//         auto txt1 = std::make_unique<std::string>("test1");
+    SECTION("move assignment", "[stack,move]")
+    {
+        typename TestType::template StackOf<std::unique_ptr<std::string>> s;
 
-//         Stack<std::unique_ptr<std::string>> s;
+        s.push(std::make_unique<std::string>("txt1"));
+        s.push(std::make_unique<std::string>("txt2"));
+        s.push(std::make_unique<std::string>("txt3"));
 
-//         s.push(move(txt1));
-//         s.push(std::make_unique<std::string>("test2"));
+        typename TestType::template StackOf<std::unique_ptr<std::string>> target;
+        target.push(std::make_unique<std::string>("x"));
 
-//         std::unique_ptr<std::string> value;
+        target = std::move(s);
 
-//         value = std::move(s.top());
-//         s.pop();
-//         REQUIRE(*value == "test2"s);
+        REQUIRE(target.size() == 3);
 
-//         value = std::move(s.top());
-//         s.pop();
-//         REQUIRE(*value == "test1"s);
-//     }
+        auto values = pop_all(target);
 
-//     SECTION("move constructor", "[stack,move]")
-//     {
-//         Stack<std::unique_ptr<std::string>> s;
+        auto expected = {"txt3", "txt2", "txt1"};
+        REQUIRE(std::equal(values.begin(), values.end(), expected.begin(), [](const auto& a, const auto& b) { return *a == b; }));
+    }
+}
 
-//         s.push(std::make_unique<std::string>("txt1"));
-//         s.push(std::make_unique<std::string>("txt2"));
-//         s.push(std::make_unique<std::string>("txt3"));
+TEST_CASE("Segmented storage", "[stack,chunks]")
+{
+    Stack<int, 4> s;
 
-//         auto moved_s = std::move(s);
+    SECTION("references stay valid after pushes")
+    {
+        s.push(1);
+        int& bottom = s.top();
 
-//         auto values = pop_all(moved_s);
+        for (int i = 2; i <= 100; ++i)
+            s.push(i);
 
-//         auto expected = {"txt3", "txt2", "txt1"};
-//         REQUIRE(std::equal(values.begin(), values.end(), expected.begin(), [](const auto& a, const auto& b) { return *a == b; }));
-//     }
+        REQUIRE(bottom == 1);
+        REQUIRE(s.size() == 100);
+    }
 
-//     SECTION("move assignment", "[stack,move]")
-//     {
-//         Stack<std::unique_ptr<std::string>> s;
+    SECTION("LIFO order across chunk boundaries")
+    {
+        for (int i = 1; i <= 10; ++i)
+            s.push(i);
 
-//         s.push(std::make_unique<std::string>("txt1"));
-//         s.push(std::make_unique<std::string>("txt2"));
-//         s.push(std::make_unique<std::string>("txt3"));
+        for (int i = 10; i >= 1; --i)
+        {
+            REQUIRE(s.top() == i);
+            s.pop();
+        }
 
-//         Stack<std::unique_ptr<std::string>> target;
-//         target.push(std::make_unique<std::string>("x"));
+        REQUIRE(s.empty());
+    }
 
-//         target = std::move(s);
+    SECTION("push/pop at chunk boundary")
+    {
+        for (int i = 1; i <= 4; ++i)
+            s.push(i);
 
-//         REQUIRE(target.size() == 3);
+        for (int n = 0; n < 10; ++n)
+        {
+            s.push(5);
+            s.pop();
+        }
 
-//         auto values = pop_all(target);
+        REQUIRE(s.top() == 4);
+        REQUIRE(s.size() == 4);
+    }
 
-//         auto expected = {"txt3", "txt2", "txt1"};
-//         REQUIRE(std::equal(values.begin(), values.end(), expected.begin(), [](const auto& a, const auto& b) { return *a == b; }));
-//     }
-// }
\ No newline at end of file
+    SECTION("copy")
+    {
+        for (int i = 1; i <= 10; ++i)
+            s.push(i);
+
+        Stack<int, 4> copy = s;
+
+        REQUIRE(copy.size() == 10);
+        for (int i = 10; i >= 1; --i)
+        {
+            REQUIRE(copy.top() == i);
+            copy.pop();
+        }
+        REQUIRE(s.top() == 10);
+    }
+}
+
+namespace
+{
+    struct ThrowingItem
+    {
+        inline static int live_count = 0;
+
+        int value;
+
+        ThrowingItem(int v)
+            : value{v}
+        {
+            if (v < 0)
+                throw std::invalid_argument("negative value");
+
+            ++live_count;
+        }
+
+        ThrowingItem(const ThrowingItem& source)
+            : value{source.value}
+        {
+            ++live_count;
+        }
+
+        ~ThrowingItem()
+        {
+            --live_count;
+        }
+    };
+} // namespace
+
+TEST_CASE("Segmented storage - throwing constructor at chunk boundary", "[stack,chunks]")
+{
+    {
+        Stack<ThrowingItem, 2> s;
+        s.emplace(1);
+        s.emplace(2); // top chunk is full
+
+        REQUIRE_THROWS_AS(s.emplace(-1), std::invalid_argument);
+
+        REQUIRE(s.size() == 2);
+        REQUIRE(s.top().value == 2);
+
+        s.emplace(3); // takes the chunk left as a spare
+        REQUIRE(s.top().value == 3);
+
+        s.pop();
+        s.pop();
+        REQUIRE(s.top().value == 1);
+        REQUIRE(ThrowingItem::live_count == 1);
+
+        SECTION("empty stack")
+        {
+            Stack<ThrowingItem, 2> empty_stack;
+            REQUIRE_THROWS_AS(empty_stack.emplace(-1), std::invalid_argument);
+
+            REQUIRE(empty_stack.empty());
+        }
+    }
+
+    REQUIRE(ThrowingItem::live_count == 0);
+}
+
+TEST_CASE("Inline storage", "[stack,small_stack]")
+{
+    using namespace std::literals;
+
+    SmallStack<std::string, 4> s;
+
+    SECTION("up to N items are stored inline")
+    {
+        for (int i = 0; i < 4; ++i)
+            s.push(std::to_string(i));
+
+        REQUIRE(s.uses_inline_storage());
+        REQUIRE(s.capacity() == 4);
+    }
+
+    SECTION("items spill to the heap beyond N")
+    {
+        for (int i = 0; i < 5; ++i)
+            s.push(std::to_string(i));
+
+        REQUIRE_FALSE(s.uses_inline_storage());
+        REQUIRE(s.capacity() == 8);
+
+        for (int i = 4; i >= 0; --i)
+        {
+            REQUIRE(s.top() == std::to_string(i));
+            s.pop();
+        }
+    }
+
+    SECTION("pushing a copy of top while spilling")
+    {
+        for (int i = 0; i < 4; ++i)
+            s.push("a long string - not affected by SSO "s + std::to_string(i));
+
+        s.push(s.top());
+
+        REQUIRE(s.top() == "a long string - not affected by SSO 3"s);
+    }
+
+    SECTION("move of inline stack")
+    {
+        s.push("txt1");
+        s.push("txt2");
+
+        auto moved_s = std::move(s);
+
+        REQUIRE(moved_s.uses_inline_storage());
+        REQUIRE(moved_s.size() == 2);
+        REQUIRE(moved_s.top() == "txt2");
+        REQUIRE(s.empty());
+    }
+
+    SECTION("move of spilled stack")
+    {
+        for (int i = 0; i < 10; ++i)
+            s.push(std::to_string(i));
+
+        const std::string* top_item = &s.top();
+
+        SmallStack<std::string, 4> target;
+        target.push("x");
+        target = std::move(s);
+
+        REQUIRE(&target.top() == top_item);
+        REQUIRE(target.size() == 10);
+        REQUIRE(s.empty());
+        REQUIRE(s.uses_inline_storage());
+
+        s.push("reused");
+        REQUIRE(s.top() == "reused");
+    }
+
+    SECTION("copy")
+    {
+        for (int i = 0; i < 6; ++i)
+            s.push(std::to_string(i));
+
+        SmallStack<std::string, 4> copy = s;
+        REQUIRE(pop_all(copy) == pop_all(s));
+    }
+}
+
+TEST_CASE("Inline storage - trivially relocatable items", "[stack,small_stack]")
+{
+    static_assert(Helpers::IsTriviallyRelocatable_v<std::unique_ptr<int>>);
+
+    SmallStack<std::unique_ptr<int>, 2> s;
+    for (int i = 0; i < 9; ++i)
+        s.push(std::make_unique<int>(i)); // spilled & grown by memcpy
+
+    auto moved_s = std::move(s);
+
+    for (int i = 8; i >= 0; --i)
+    {
+        REQUIRE(*moved_s.top() == i);
+        moved_s.pop();
+    }
+}
+
+TEST_CASE("noexcept audit - stacks", "[stack]")
+{
+    static_assert(Helpers::assert_nothrow_movable<Stack<std::string>>());
+    static_assert(Helpers::assert_nothrow_movable<SmallStack<std::string, 4>>());
+
+    Helpers::ReallocationAudit audit;
+
+    {
+        std::vector<SmallStack<std::string, 4>, Helpers::AuditingAllocator<SmallStack<std::string, 4>>> stacks{
+            Helpers::AuditingAllocator<SmallStack<std::string, 4>>{audit}};
+        for (int i = 0; i < 100; ++i)
+            stacks.emplace_back().push(std::to_string(i));
+    }
+
+    REQUIRE(audit.copy_fallbacks == 0);
+}
+
+namespace Benchmark
+{
+    template <typename TStack>
+    void report_latencies(const std::string& name, int count)
+    {
+        using Clock = std::chrono::steady_clock;
+
+        std::vector<Clock::duration> push_latencies(count);
+        std::vector<Clock::duration> pop_latencies(count);
+
+        TStack s;
+
+        for (int i = 0; i < count; ++i)
+        {
+            auto start = Clock::now();
+            s.push(std::to_string(i));
+            push_latencies[i] = Clock::now() - start;
+        }
+
+        for (int i = 0; i < count; ++i)
+        {
+            auto start = Clock::now();
+            s.pop();
+            pop_latencies[i] = Clock::now() - start;
+        }
+
+        auto print = [&](const char* operation, std::vector<Clock::duration>& latencies) {
+            std::sort(latencies.begin(), latencies.end());
+            auto percentile = [&](double p) { return std::chrono::nanoseconds{latencies[static_cast<size_t>(p * (count - 1))]}.count(); };
+
+            std::cout << name << " - " << operation << " [ns] - p50: " << percentile(0.5) << ", p99: " << percentile(0.99)
+                      << ", p99.9: " << percentile(0.999) << ", max: " << percentile(1.0) << "\n";
+        };
+
+        print("push", push_latencies);
+        print("pop", pop_latencies);
+    }
+
+    // short-lived stacks - as created by each level of a recursive descent parser
+    template <typename TStack>
+    int nested_scopes(int depth)
+    {
+        TStack s;
+
+        for (int i = 0; i < 8; ++i)
+            s.push(depth + i);
+
+        int result = depth > 0 ? nested_scopes<TStack>(depth - 1) : 0;
+
+        while (!s.empty())
+        {
+            result += s.top();
+            s.pop();
+        }
+
+        return result;
+    }
+} // namespace Benchmark
+
+TEST_CASE("Stack - push/pop latency percentiles", "[.benchmark]")
+{
+    constexpr int count = 1'000'000;
+
+    Benchmark::report_latencies<Stack<std::string>>("Stack (chunks)", count);
+    Benchmark::report_latencies<std::stack<std::string, std::vector<std::string>>>("std::stack<vector>", count);
+    Benchmark::report_latencies<std::stack<std::string, std::deque<std::string>>>("std::stack<deque>", count);
+}
+
+TEST_CASE("Short-lived stacks - create/push/pop/destroy", "[.benchmark]")
+{
+    constexpr int depth = 1'000;
+
+    BENCHMARK("Stack (chunks)")
+    {
+        return Benchmark::nested_scopes<Stack<int>>(depth);
+    };
+
+    BENCHMARK("SmallStack<int, 16>")
+    {
+        return Benchmark::nested_scopes<SmallStack<int, 16>>(depth);
+    };
+
+    BENCHMARK("std::stack<vector>")
+    {
+        return Benchmark::nested_scopes<std::stack<int, std::vector<int>>>(depth);
+    };
+}
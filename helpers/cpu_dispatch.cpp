@@ -0,0 +1,187 @@
+#include "cpu_dispatch.hpp"
+
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <mutex>
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <immintrin.h>
+#include <intrin.h>
+#define CPU_DISPATCH_X86
+#elif defined(__x86_64__) || defined(__i386__)
+#include <cpuid.h>
+#define CPU_DISPATCH_X86
+#endif
+
+namespace Helpers
+{
+    namespace
+    {
+#ifdef CPU_DISPATCH_X86
+        struct CpuidRegisters
+        {
+            std::uint32_t eax, ebx, ecx, edx;
+        };
+
+        CpuidRegisters cpuid(std::uint32_t leaf, std::uint32_t subleaf = 0)
+        {
+            CpuidRegisters registers{};
+#ifdef _MSC_VER
+            int values[4];
+            __cpuidex(values, static_cast<int>(leaf), static_cast<int>(subleaf));
+            registers = {static_cast<std::uint32_t>(values[0]), static_cast<std::uint32_t>(values[1]),
+                static_cast<std::uint32_t>(values[2]), static_cast<std::uint32_t>(values[3])};
+#else
+            __cpuid_count(leaf, subleaf, registers.eax, registers.ebx, registers.ecx, registers.edx);
+#endif
+            return registers;
+        }
+
+        // register state enabled by the OS (XCR0)
+        std::uint64_t xgetbv()
+        {
+#ifdef _MSC_VER
+            return _xgetbv(0);
+#else
+            std::uint32_t eax, edx;
+            __asm__("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+            return (std::uint64_t{edx} << 32) | eax;
+#endif
+        }
+
+        bool bit(std::uint32_t value, int index)
+        {
+            return (value >> index) & 1;
+        }
+
+        CpuFeatures detect_cpu_features()
+        {
+            CpuFeatures features{};
+
+            const std::uint32_t max_leaf = cpuid(0).eax;
+
+            const CpuidRegisters leaf1 = cpuid(1);
+            features.sse2 = bit(leaf1.edx, 26);
+            features.ssse3 = bit(leaf1.ecx, 9);
+            features.sse42 = bit(leaf1.ecx, 20);
+            features.popcnt = bit(leaf1.ecx, 23);
+
+            if (bit(leaf1.ecx, 27)) // OSXSAVE
+            {
+                const std::uint64_t xcr0 = xgetbv();
+                features.os_ymm_state = (xcr0 & 0x06) == 0x06; // SSE & AVX state
+                features.os_zmm_state = (xcr0 & 0xE6) == 0xE6; // + opmask & ZMM state
+            }
+
+            if (max_leaf >= 7)
+            {
+                const CpuidRegisters leaf7 = cpuid(7, 0);
+                features.avx2 = bit(leaf7.ebx, 5);
+                features.avx512f = bit(leaf7.ebx, 16);
+                features.avx512dq = bit(leaf7.ebx, 17);
+                features.avx512bw = bit(leaf7.ebx, 30);
+                features.avx512vl = bit(leaf7.ebx, 31);
+            }
+
+            return features;
+        }
+#else
+        CpuFeatures detect_cpu_features()
+        {
+            return CpuFeatures{};
+        }
+#endif
+
+        SimdLevel level_of(const CpuFeatures& features)
+        {
+            if (!features.sse2)
+                return SimdLevel::Scalar;
+
+            if (!(features.ssse3 && features.sse42 && features.popcnt))
+                return SimdLevel::Sse2;
+
+            if (!(features.avx2 && features.os_ymm_state))
+                return SimdLevel::Sse42;
+
+            if (!(features.avx512f && features.avx512bw && features.avx512vl && features.avx512dq && features.os_zmm_state))
+                return SimdLevel::Avx2;
+
+            return SimdLevel::Avx512;
+        }
+
+        constexpr std::pair<SimdLevel, std::string_view> level_names[] = {
+            {SimdLevel::Scalar, "scalar"},
+            {SimdLevel::Sse2, "sse2"},
+            {SimdLevel::Sse42, "sse42"},
+            {SimdLevel::Avx2, "avx2"},
+            {SimdLevel::Avx512, "avx512"}};
+    } // namespace
+
+    std::string_view to_string(SimdLevel level)
+    {
+        return level_names[static_cast<std::size_t>(level)].second;
+    }
+
+    std::optional<SimdLevel> parse_simd_level(std::string_view name)
+    {
+        for (const auto& [level, level_name] : level_names)
+        {
+            if (name == level_name)
+                return level;
+        }
+
+        return std::nullopt;
+    }
+
+    const CpuFeatures& cpu_features()
+    {
+        static const CpuFeatures features = detect_cpu_features();
+        return features;
+    }
+
+    SimdLevel supported_simd_level()
+    {
+        static const SimdLevel level = level_of(cpu_features());
+        return level;
+    }
+
+    SimdLevel Details::initialize_active_simd_level()
+    {
+        static std::once_flag initialized;
+
+        std::call_once(initialized, [] {
+            SimdLevel level = supported_simd_level();
+
+            if (const char* forced = std::getenv(simd_level_env_variable))
+            {
+                if (const auto forced_level = parse_simd_level(forced))
+                {
+                    if (*forced_level > level)
+                        std::cerr << simd_level_env_variable << "=" << forced << " is not supported by the CPU - using " << to_string(level) << "\n";
+                    else
+                        level = *forced_level;
+                }
+                else
+                {
+                    std::cerr << "Unknown " << simd_level_env_variable << "=" << forced << " - using " << to_string(level) << "\n";
+                }
+            }
+
+            active_simd_level.store(static_cast<int>(level), std::memory_order_relaxed);
+        });
+
+        return static_cast<SimdLevel>(active_simd_level.load(std::memory_order_relaxed));
+    }
+
+    bool set_active_simd_level(SimdLevel level)
+    {
+        Details::initialize_active_simd_level(); // an explicit choice is not overwritten later by the environment
+
+        if (level > supported_simd_level())
+            return false;
+
+        Details::active_simd_level.store(static_cast<int>(level), std::memory_order_relaxed);
+        return true;
+    }
+} // namespace Helpers
@@ -0,0 +1,115 @@
+#ifndef CPU_DISPATCH_HPP
+#define CPU_DISPATCH_HPP
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <initializer_list>
+#include <optional>
+#include <string_view>
+#include <utility>
+
+namespace Helpers
+{
+    // instruction set levels of SIMD kernels - each one implies the previous ones
+    enum class SimdLevel : int {
+        Scalar,
+        Sse2,
+        Sse42,  // + SSSE3, POPCNT
+        Avx2,   // + POPCNT, OS support for YMM state
+        Avx512  // F, BW, VL, DQ + OS support for ZMM state
+    };
+
+    inline constexpr std::size_t simd_level_count = 5;
+
+    // forces a level (scalar, sse2, sse42, avx2, avx512) - capped to the level supported by the CPU
+    inline constexpr const char* simd_level_env_variable = "CPP_ADV_SIMD_LEVEL";
+
+    std::string_view to_string(SimdLevel level);
+    std::optional<SimdLevel> parse_simd_level(std::string_view name);
+
+    struct CpuFeatures
+    {
+        bool sse2{};
+        bool ssse3{};
+        bool sse42{};
+        bool popcnt{};
+        bool avx2{};
+        bool avx512f{};
+        bool avx512bw{};
+        bool avx512vl{};
+        bool avx512dq{};
+        bool os_ymm_state{};
+        bool os_zmm_state{};
+    };
+
+    // detected once (cpuid & xgetbv)
+    const CpuFeatures& cpu_features();
+
+    SimdLevel supported_simd_level();
+
+    namespace Details
+    {
+        inline constexpr int unknown_simd_level = -1;
+
+        inline std::atomic<int> active_simd_level{unknown_simd_level};
+
+        SimdLevel initialize_active_simd_level();
+    } // namespace Details
+
+    // supported level or the one forced by CPP_ADV_SIMD_LEVEL
+    inline SimdLevel active_simd_level()
+    {
+        const int level = Details::active_simd_level.load(std::memory_order_relaxed);
+
+        if (level == Details::unknown_simd_level) [[unlikely]]
+            return Details::initialize_active_simd_level();
+
+        return static_cast<SimdLevel>(level);
+    }
+
+    // for tests - returns false (and changes nothing) if the CPU does not support the level
+    bool set_active_simd_level(SimdLevel level);
+
+    // Variants of a kernel (function pointers, tables of them, ...) registered for instruction set levels
+    // - active() returns the best variant not above the active level
+    template <typename TVariant>
+    class DispatchTable
+    {
+        std::array<std::optional<std::pair<SimdLevel, TVariant>>, simd_level_count> best_;
+
+    public:
+        // the lowest registered variant serves also levels below it (it must run on every target CPU)
+        DispatchTable(std::initializer_list<std::pair<SimdLevel, TVariant>> variants)
+        {
+            assert(variants.size() > 0);
+
+            for (const auto& [level, variant] : variants)
+            {
+                for (std::size_t i = static_cast<std::size_t>(level); i < simd_level_count; ++i)
+                {
+                    if (!best_[i] || best_[i]->first < level)
+                        best_[i] = std::pair{level, variant};
+                }
+            }
+
+            const auto lowest = std::find_if(best_.begin(), best_.end(), [](const auto& entry) { return entry.has_value(); });
+            std::fill(best_.begin(), lowest, *lowest);
+        }
+
+        const TVariant& active() const
+        {
+            return best_[static_cast<std::size_t>(active_simd_level())]->second;
+        }
+
+        // for logging
+        SimdLevel active_variant() const
+        {
+            return best_[static_cast<std::size_t>(active_simd_level())]->first;
+        }
+    };
+} // namespace Helpers
+
+#endif
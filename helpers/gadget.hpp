@@ -69,7 +69,7 @@ namespace Helpers
             }
         }
 
-        Gadget& operator=(Gadget&& source)
+        Gadget& operator=(Gadget&& source) noexcept
         {
             if (this != &source)
             {
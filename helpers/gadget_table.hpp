@@ -0,0 +1,175 @@
+#ifndef GADGET_TABLE_HPP
+#define GADGET_TABLE_HPP
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <limits>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace Helpers
+{
+    // Structure of arrays for gadgets - ids in one contiguous array, names in one string arena
+    // Creating n gadgets costs one allocation (ids); names are allocated only when first set.
+    class GadgetTable
+    {
+        struct NameSpan
+        {
+            std::uint32_t offset;
+            std::uint32_t length;
+        };
+
+        std::vector<int> ids_;
+        std::vector<NameSpan> name_spans_; // empty until the first set_name()
+        std::string names_;
+
+        void grow_to(std::size_t new_size)
+        {
+            if (new_size > ids_.capacity())
+                ids_.reserve(std::max(new_size, 2 * ids_.capacity()));
+
+            ids_.resize(new_size);
+
+            if (!name_spans_.empty())
+                name_spans_.resize(new_size, NameSpan{0, 0});
+        }
+
+    public:
+        // view of one row - looks like a Gadget
+        class GadgetRef
+        {
+            GadgetTable* table_;
+            std::size_t index_;
+
+        public:
+            GadgetRef(GadgetTable& table, std::size_t index)
+                : table_{&table}
+                , index_{index}
+            { }
+
+            int id() const
+            {
+                return table_->ids_[index_];
+            }
+
+            void set_id(int id)
+            {
+                table_->ids_[index_] = id;
+            }
+
+            std::string_view name() const
+            {
+                return table_->name(index_);
+            }
+
+            void set_name(std::string_view name)
+            {
+                table_->set_name(index_, name);
+            }
+
+            void use() const
+            {
+                std::cout << "Using a gadget with id: " << id() << '\n';
+            }
+
+            void unsafe() const
+            {
+                std::cout << "Using a gadget with id: " << id() << " - Ups... It crashed..." << std::endl;
+                throw std::runtime_error("ERROR");
+            }
+        };
+
+        GadgetTable() = default;
+
+        explicit GadgetTable(std::size_t size)
+        {
+            create(size);
+        }
+
+        // appends n gadgets - ids are set to their positions in a table
+        void create(std::size_t n)
+        {
+            const std::size_t first = ids_.size();
+            grow_to(first + n);
+
+            int* ids = ids_.data();
+            for (std::size_t i = first; i < ids_.size(); ++i)
+                ids[i] = static_cast<int>(i);
+        }
+
+        std::size_t size() const
+        {
+            return ids_.size();
+        }
+
+        bool empty() const
+        {
+            return ids_.empty();
+        }
+
+        GadgetRef operator[](std::size_t index)
+        {
+            assert(index < size());
+            return GadgetRef{*this, index};
+        }
+
+        int id(std::size_t index) const
+        {
+            return ids_[index];
+        }
+
+        std::span<const int> ids() const
+        {
+            return ids_;
+        }
+
+        std::string_view name(std::size_t index) const
+        {
+            if (name_spans_.empty())
+                return {};
+
+            const NameSpan span = name_spans_[index];
+            return std::string_view{names_}.substr(span.offset, span.length);
+        }
+
+        // appends a name to the arena - a previous name of the gadget is not reclaimed
+        void set_name(std::size_t index, std::string_view name)
+        {
+            if (name_spans_.empty())
+                name_spans_.resize(size(), NameSpan{0, 0});
+
+            // spans keep 32-bit offsets - the arena is limited to 4 GiB
+            constexpr std::size_t max_offset = std::numeric_limits<std::uint32_t>::max();
+            if (names_.size() > max_offset || name.size() > max_offset)
+                throw std::length_error("GadgetTable - names exceed 32-bit offsets");
+
+            name_spans_[index] = NameSpan{static_cast<std::uint32_t>(names_.size()), static_cast<std::uint32_t>(name.size())};
+            names_.append(name);
+        }
+
+        template <typename Function>
+        void for_each_id(Function f) const
+        {
+            for (int id : ids_)
+                f(id);
+        }
+
+        // ids = start, start + 1, ... - a plain loop over int* that compilers vectorize
+        void reset_ids(int start)
+        {
+            int* ids = ids_.data();
+            const std::size_t count = ids_.size();
+
+            for (std::size_t i = 0; i < count; ++i)
+                ids[i] = start + static_cast<int>(i);
+        }
+    };
+} // namespace Helpers
+
+#endif
@@ -0,0 +1,232 @@
+#ifndef GRAPH_ARENA_HPP
+#define GRAPH_ARENA_HPP
+
+#include "handle.hpp"
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace Helpers
+{
+    // Arena for object graphs - nodes live in one contiguous block of slots
+    // and refer to each other through generational handles (no ref-counting, no cycles to leak).
+    // Destroying the arena releases the whole graph at once.
+    template <typename T>
+    class GraphArena
+    {
+    public:
+        using Handle = Helpers::Handle<T>;
+
+    private:
+        static constexpr std::uint32_t no_free_slot = std::numeric_limits<std::uint32_t>::max();
+        static constexpr std::uint32_t retired_generation = std::numeric_limits<std::uint32_t>::max() - 1;
+
+        // generation is odd when the slot is alive, even when it is free
+        // every slot in slots_ was used at least once - generation 0 (null handle) never matches
+        struct Slot
+        {
+            std::uint32_t generation{};
+            std::uint32_t next_free{no_free_slot};
+
+            union
+            {
+                T value;
+            };
+
+            Slot() { }
+
+            Slot(Slot&& source) noexcept(std::is_nothrow_move_constructible_v<T>)
+                : generation{source.generation}
+                , next_free{source.next_free}
+            {
+                if (is_alive())
+                    std::construct_at(&value, std::move(source.value));
+            }
+
+            Slot& operator=(Slot&&) = delete;
+
+            ~Slot() requires std::is_trivially_destructible_v<T> = default;
+
+            ~Slot()
+            {
+                if (is_alive())
+                    std::destroy_at(&value);
+            }
+
+            bool is_alive() const
+            {
+                return generation & 1u;
+            }
+        };
+
+        std::vector<Slot> slots_;
+        std::uint32_t free_head_{no_free_slot};
+        std::size_t size_{};
+
+    public:
+        GraphArena() = default;
+
+        explicit GraphArena(std::size_t capacity)
+        {
+            slots_.reserve(capacity);
+        }
+
+        GraphArena(const GraphArena&) = delete;
+        GraphArena& operator=(const GraphArena&) = delete;
+
+        GraphArena(GraphArena&& source) noexcept
+            : slots_{std::move(source.slots_)}
+            , free_head_{std::exchange(source.free_head_, no_free_slot)}
+            , size_{std::exchange(source.size_, 0)}
+        { }
+
+        GraphArena& operator=(GraphArena&& source) noexcept
+        {
+            if (this != &source)
+            {
+                slots_ = std::move(source.slots_);
+                free_head_ = std::exchange(source.free_head_, no_free_slot);
+                size_ = std::exchange(source.size_, 0);
+            }
+
+            return *this;
+        }
+
+        ~GraphArena() = default;
+
+        template <typename... TArgs>
+        Handle create(TArgs&&... args)
+        {
+            std::uint32_t index;
+
+            // if a constructor of T throws, the arena is left unchanged
+            if (free_head_ != no_free_slot)
+            {
+                index = free_head_;
+                Slot& slot = slots_[index];
+                const std::uint32_t next_free = slot.next_free; // read before the value is constructed
+                std::construct_at(&slot.value, std::forward<TArgs>(args)...);
+                free_head_ = next_free;
+                ++slot.generation;
+            }
+            else
+            {
+                assert(slots_.size() < no_free_slot);
+                index = static_cast<std::uint32_t>(slots_.size());
+                Slot& slot = slots_.emplace_back();
+
+                try
+                {
+                    std::construct_at(&slot.value, std::forward<TArgs>(args)...);
+                }
+                catch (...)
+                {
+                    slots_.pop_back(); // never used slot - neither alive nor free
+                    throw;
+                }
+
+                slot.generation = 1;
+            }
+
+            ++size_;
+
+            return Handle{index, slots_[index].generation};
+        }
+
+        // destroys a node - all handles to it become stale
+        void destroy(Handle h)
+        {
+            if (!contains(h))
+                return;
+
+            Slot& slot = slots_[h.index()];
+            std::destroy_at(&slot.value);
+            ++slot.generation;
+            --size_;
+
+            if (slot.generation != retired_generation) // never reuse a slot with exhausted generations
+            {
+                slot.next_free = free_head_;
+                free_head_ = h.index();
+            }
+        }
+
+        bool contains(Handle h) const
+        {
+            return h.index() < slots_.size() && slots_[h.index()].generation == h.generation();
+        }
+
+        // returns nullptr for a stale handle
+        // pointer is invalidated by next create()
+        T* get(Handle h)
+        {
+            return contains(h) ? &slots_[h.index()].value : nullptr;
+        }
+
+        const T* get(Handle h) const
+        {
+            return contains(h) ? &slots_[h.index()].value : nullptr;
+        }
+
+        T& operator[](Handle h)
+        {
+            assert(contains(h));
+            return slots_[h.index()].value;
+        }
+
+        const T& operator[](Handle h) const
+        {
+            assert(contains(h));
+            return slots_[h.index()].value;
+        }
+
+        template <typename Function>
+        void for_each(Function f)
+        {
+            for (std::uint32_t index = 0; index < slots_.size(); ++index)
+            {
+                Slot& slot = slots_[index];
+                if (slot.is_alive())
+                    f(Handle{index, slot.generation}, slot.value);
+            }
+        }
+
+        std::size_t size() const
+        {
+            return size_;
+        }
+
+        bool empty() const
+        {
+            return size_ == 0;
+        }
+
+        std::size_t capacity() const
+        {
+            return slots_.capacity();
+        }
+
+        void reserve(std::size_t capacity)
+        {
+            slots_.reserve(capacity);
+        }
+
+        // destroys all nodes but keeps generations - handles issued before clear() stay stale
+        void clear()
+        {
+            for (std::uint32_t index = 0; index < slots_.size(); ++index)
+            {
+                if (slots_[index].is_alive())
+                    destroy(Handle{index, slots_[index].generation});
+            }
+        }
+    };
+} // namespace Helpers
+
+#endif
@@ -0,0 +1,56 @@
+#ifndef HANDLE_HPP
+#define HANDLE_HPP
+
+#include <cstdint>
+#include <functional>
+
+namespace Helpers
+{
+    // 64-bit generational handle: [ generation (32 bits) | index (32 bits) ]
+    // generation == 0 is never issued - default constructed handle is a null handle
+    template <typename T>
+    class Handle
+    {
+        std::uint64_t value_{};
+
+    public:
+        constexpr Handle() = default;
+
+        constexpr Handle(std::uint32_t index, std::uint32_t generation)
+            : value_{(static_cast<std::uint64_t>(generation) << 32) | index}
+        { }
+
+        constexpr std::uint32_t index() const
+        {
+            return static_cast<std::uint32_t>(value_);
+        }
+
+        constexpr std::uint32_t generation() const
+        {
+            return static_cast<std::uint32_t>(value_ >> 32);
+        }
+
+        constexpr std::uint64_t value() const
+        {
+            return value_;
+        }
+
+        constexpr explicit operator bool() const
+        {
+            return generation() != 0;
+        }
+
+        friend constexpr bool operator==(Handle, Handle) = default;
+    };
+} // namespace Helpers
+
+template <typename T>
+struct std::hash<Helpers::Handle<T>>
+{
+    std::size_t operator()(Helpers::Handle<T> h) const noexcept
+    {
+        return std::hash<std::uint64_t>{}(h.value());
+    }
+};
+
+#endif
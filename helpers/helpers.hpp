@@ -2,12 +2,15 @@
 #define HELPERS_HPP
 
 #include <iostream>
+#include <memory>
+#include <memory_resource>
 #include <string_view>
 #include <vector>
 #include <string>
 #include <cstdint>
 
 #include "gadget.hpp"
+#include "relocation.hpp"
 
 namespace Helpers
 {
@@ -133,7 +136,7 @@ namespace Helpers
             ++move_constructor_count;
         }
 
-        String& operator=(String&& source)
+        String& operator=(String&& source) noexcept
         {
             if (this != &source)
             {
@@ -163,6 +166,11 @@ namespace Helpers
         }
     };
 
+    // relocatable when its std::string is (libc++)
+    template <>
+    struct IsTriviallyRelocatable<String> : IsTriviallyRelocatable<std::string>
+    {};
+
     inline String operator+(const String& lhs, const String& rhs)
     {
         return String{lhs.value() + rhs.value()};
@@ -174,14 +182,22 @@ namespace Helpers
         return out;
     }
 
-    struct Vector : std::vector<String>
+    template <typename TAllocator = std::allocator<String>>
+    struct BasicVector : std::vector<String, TAllocator>
     {
-        using std::vector<String>::vector;
+        using std::vector<String, TAllocator>::vector;
 
 #ifndef ENABLE_MOVE_SEMANTICS
-        ~Vector() = default;
+        ~BasicVector() = default;
 #endif
     };
+
+    using Vector = BasicVector<>;
+
+    namespace pmr
+    {
+        using Vector = BasicVector<std::pmr::polymorphic_allocator<String>>;
+    }
 } // namespace Helpers
 
 #endif
\ No newline at end of file
@@ -0,0 +1,162 @@
+#ifndef MEMORY_RESOURCES_HPP
+#define MEMORY_RESOURCES_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <memory_resource>
+#include <new>
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+namespace Helpers
+{
+    // Monotonic arena with an inline buffer - placed on the stack it serves small request-scoped
+    // containers without touching the heap; when the buffer is exhausted it takes chunks from upstream
+    //  - deallocate() is a no-op, release() (or the destructor) frees everything in O(1) for the inline buffer
+    template <std::size_t Size>
+    class StackBufferResource : public std::pmr::memory_resource
+    {
+        alignas(std::max_align_t) std::byte buffer_[Size];
+        std::pmr::monotonic_buffer_resource arena_;
+
+    public:
+        explicit StackBufferResource(std::pmr::memory_resource* upstream = std::pmr::get_default_resource())
+            : arena_{buffer_, Size, upstream}
+        { }
+
+        StackBufferResource(const StackBufferResource&) = delete;
+        StackBufferResource& operator=(const StackBufferResource&) = delete;
+
+        static constexpr std::size_t buffer_size()
+        {
+            return Size;
+        }
+
+        void release()
+        {
+            arena_.release();
+        }
+
+    protected:
+        void* do_allocate(std::size_t bytes, std::size_t alignment) override
+        {
+            return arena_.allocate(bytes, alignment);
+        }
+
+        void do_deallocate(void*, std::size_t, std::size_t) override
+        { }
+
+        bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override
+        {
+            return this == &other;
+        }
+    };
+
+    // Pools of fixed-size blocks for a single thread - no locks, memory reused after deallocation
+    //  - defaults tuned for containers of small objects (blocks up to 4 KiB, chunks of up to 1024 blocks)
+    class UnsynchronizedPoolResource : public std::pmr::unsynchronized_pool_resource
+    {
+    public:
+        static constexpr std::pmr::pool_options default_options{.max_blocks_per_chunk = 1024, .largest_required_pool_block = 4096};
+
+        explicit UnsynchronizedPoolResource(std::pmr::memory_resource* upstream = std::pmr::get_default_resource())
+            : std::pmr::unsynchronized_pool_resource{default_options, upstream}
+        { }
+
+        UnsynchronizedPoolResource(const std::pmr::pool_options& options, std::pmr::memory_resource* upstream = std::pmr::get_default_resource())
+            : std::pmr::unsynchronized_pool_resource{options, upstream}
+        { }
+    };
+
+    // Page-aligned memory from the OS - meant as upstream of an arena or a pool
+    //  - on Linux allocations of at least huge_page_size are aligned to 2 MiB & advised
+    //    as transparent huge pages (fewer TLB misses for large containers)
+    //  - elsewhere falls back to aligned operator new
+    class HugePageResource : public std::pmr::memory_resource
+    {
+    public:
+        static constexpr std::size_t huge_page_size = 2 * 1024 * 1024;
+
+        static std::size_t page_size()
+        {
+#if defined(__linux__)
+            static const std::size_t size = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+            return size;
+#else
+            return 4096;
+#endif
+        }
+
+    protected:
+        void* do_allocate(std::size_t bytes, std::size_t alignment) override
+        {
+            const std::size_t page_alignment = mapping_alignment(bytes, alignment);
+            const std::size_t size = round_up(bytes == 0 ? 1 : bytes, page_alignment);
+
+#if defined(__linux__)
+            // over-allocate & trim - mmap guarantees only the alignment of a regular page
+            const std::size_t mapped_size = size + page_alignment - page_size();
+            void* mapped = ::mmap(nullptr, mapped_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+            if (mapped == MAP_FAILED)
+                throw std::bad_alloc{};
+
+            auto* first = static_cast<std::byte*>(mapped);
+            auto* aligned = reinterpret_cast<std::byte*>(round_up(reinterpret_cast<std::size_t>(first), page_alignment));
+
+            if (aligned != first)
+                ::munmap(first, static_cast<std::size_t>(aligned - first));
+            if (std::byte* tail = aligned + size; tail != first + mapped_size)
+                ::munmap(tail, static_cast<std::size_t>(first + mapped_size - tail));
+
+#if defined(MADV_HUGEPAGE)
+            if (page_alignment == huge_page_size)
+                ::madvise(aligned, size, MADV_HUGEPAGE); // only a hint - ignored when THP is disabled
+#endif
+            return aligned;
+#else
+            return ::operator new(size, std::align_val_t{page_alignment});
+#endif
+        }
+
+        void do_deallocate(void* p, std::size_t bytes, std::size_t alignment) override
+        {
+            const std::size_t page_alignment = mapping_alignment(bytes, alignment);
+
+#if defined(__linux__)
+            ::munmap(p, round_up(bytes == 0 ? 1 : bytes, page_alignment));
+#else
+            ::operator delete(p, std::align_val_t{page_alignment});
+#endif
+        }
+
+        bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override
+        {
+            return dynamic_cast<const HugePageResource*>(&other) != nullptr; // stateless
+        }
+
+    private:
+        // alignments stricter than a page (or a huge page) round the mapping up to the requested alignment
+        static std::size_t mapping_alignment(std::size_t bytes, std::size_t alignment)
+        {
+            const std::size_t page_alignment = bytes >= huge_page_size ? huge_page_size : page_size();
+            return std::max(page_alignment, alignment);
+        }
+
+        static std::size_t round_up(std::size_t value, std::size_t alignment)
+        {
+            return (value + alignment - 1) / alignment * alignment;
+        }
+    };
+
+    // process-wide instance (the resource is stateless)
+    inline HugePageResource* huge_page_resource()
+    {
+        static HugePageResource resource;
+        return &resource;
+    }
+} // namespace Helpers
+
+#endif
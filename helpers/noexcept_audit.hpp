@@ -0,0 +1,211 @@
+#ifndef NOEXCEPT_AUDIT_HPP
+#define NOEXCEPT_AUDIT_HPP
+
+#include <cstddef>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+namespace Helpers
+{
+    ////////////////////////////////////////////////////////
+    // SpecialMembers<T> - compile-time report of special members of T
+    //  - members are checked as overload resolution selects them, e.g. move_constructor of a type
+    //    without a move constructor describes its copy constructor
+
+    enum class MemberGuarantee
+    {
+        deleted,
+        may_throw,
+        nothrow,
+        trivial
+    };
+
+    inline std::ostream& operator<<(std::ostream& out, MemberGuarantee guarantee)
+    {
+        constexpr std::string_view names[] = {"deleted", "may throw", "noexcept", "trivial"};
+        return out << names[static_cast<int>(guarantee)];
+    }
+
+    template <bool IsAvailable, bool IsNothrow, bool IsTrivial>
+    constexpr MemberGuarantee member_guarantee()
+    {
+        if constexpr (!IsAvailable)
+            return MemberGuarantee::deleted;
+        else if constexpr (IsTrivial)
+            return MemberGuarantee::trivial;
+        else if constexpr (IsNothrow)
+            return MemberGuarantee::nothrow;
+        else
+            return MemberGuarantee::may_throw;
+    }
+
+    template <typename T>
+    struct SpecialMembers
+    {
+        static constexpr MemberGuarantee default_constructor = member_guarantee<
+            std::is_default_constructible_v<T>, std::is_nothrow_default_constructible_v<T>, std::is_trivially_default_constructible_v<T>>();
+
+        static constexpr MemberGuarantee copy_constructor = member_guarantee<
+            std::is_copy_constructible_v<T>, std::is_nothrow_copy_constructible_v<T>, std::is_trivially_copy_constructible_v<T>>();
+
+        static constexpr MemberGuarantee move_constructor = member_guarantee<
+            std::is_move_constructible_v<T>, std::is_nothrow_move_constructible_v<T>, std::is_trivially_move_constructible_v<T>>();
+
+        static constexpr MemberGuarantee copy_assignment = member_guarantee<
+            std::is_copy_assignable_v<T>, std::is_nothrow_copy_assignable_v<T>, std::is_trivially_copy_assignable_v<T>>();
+
+        static constexpr MemberGuarantee move_assignment = member_guarantee<
+            std::is_move_assignable_v<T>, std::is_nothrow_move_assignable_v<T>, std::is_trivially_move_assignable_v<T>>();
+
+        static constexpr MemberGuarantee destructor = member_guarantee<
+            std::is_destructible_v<T>, std::is_nothrow_destructible_v<T>, std::is_trivially_destructible_v<T>>();
+
+        // containers move (instead of copying) items on reallocation only when this holds - see std::move_if_noexcept
+        static constexpr bool is_moved_on_reallocation = move_constructor >= MemberGuarantee::nothrow || copy_constructor == MemberGuarantee::deleted;
+    };
+
+    template <typename T>
+    void print_special_members(std::string_view name)
+    {
+        using Members = SpecialMembers<T>;
+
+        std::cout << name << ":\n"
+                  << "  default constructor: " << Members::default_constructor << "\n"
+                  << "  copy constructor:    " << Members::copy_constructor << "\n"
+                  << "  move constructor:    " << Members::move_constructor << "\n"
+                  << "  copy assignment:     " << Members::copy_assignment << "\n"
+                  << "  move assignment:     " << Members::move_assignment << "\n"
+                  << "  destructor:          " << Members::destructor << "\n";
+    }
+
+    // static_assert(Helpers::assert_nothrow_movable<T>()) - a failing member is named in the error message
+    template <typename T>
+    constexpr bool assert_nothrow_movable()
+    {
+        static_assert(std::is_nothrow_move_constructible_v<T>,
+            "move constructor is not noexcept - std::move_if_noexcept copies items on reallocation");
+        static_assert(!std::is_move_assignable_v<T> || std::is_nothrow_move_assignable_v<T>,
+            "move assignment is not noexcept");
+        static_assert(std::is_nothrow_destructible_v<T>, "destructor is not noexcept");
+
+        return true;
+    }
+
+    ////////////////////////////////////////////////////////
+    // ReallocationAudit - counts items a container copied (instead of moving) while reallocating
+    //  - collected by containers using AuditingAllocator in debug builds (NDEBUG not defined)
+    //  - a reallocation is an allocation made while the previous block is still alive,
+    //    a copy fallback is a copy construction (from const T&) of an item of that previous block
+
+#ifdef NDEBUG
+    inline constexpr bool reallocation_audit_enabled = false;
+#else
+    inline constexpr bool reallocation_audit_enabled = true;
+#endif
+
+    struct ReallocationAudit
+    {
+        std::size_t reallocations{};
+        std::size_t copy_fallbacks{};
+
+        const void* live_block{};
+        std::size_t live_block_size{};
+        const void* previous_block{};
+        std::size_t previous_block_size{};
+
+        void clear()
+        {
+            *this = ReallocationAudit{};
+        }
+    };
+
+    // allocator of a single container - audit must outlive it
+    template <typename T>
+    class AuditingAllocator
+    {
+        template <typename U>
+        friend class AuditingAllocator;
+
+        ReallocationAudit* audit_;
+
+        bool is_in_previous_block(const void* item) const
+        {
+            const auto* first = static_cast<const std::byte*>(audit_->previous_block);
+            const auto* address = static_cast<const std::byte*>(item);
+
+            return first != nullptr
+                && std::greater_equal<>{}(address, first)
+                && std::less<>{}(address, first + audit_->previous_block_size);
+        }
+
+    public:
+        using value_type = T;
+
+        explicit AuditingAllocator(ReallocationAudit& audit) noexcept
+            : audit_{&audit}
+        { }
+
+        template <typename U>
+        AuditingAllocator(const AuditingAllocator<U>& other) noexcept
+            : audit_{other.audit_}
+        { }
+
+        T* allocate(std::size_t n)
+        {
+            T* block = std::allocator<T>{}.allocate(n);
+
+            if constexpr (reallocation_audit_enabled)
+            {
+                if (audit_->live_block)
+                {
+                    ++audit_->reallocations;
+                    audit_->previous_block = audit_->live_block;
+                    audit_->previous_block_size = audit_->live_block_size;
+                }
+
+                audit_->live_block = block;
+                audit_->live_block_size = n * sizeof(T);
+            }
+
+            return block;
+        }
+
+        void deallocate(T* block, std::size_t n) noexcept
+        {
+            if constexpr (reallocation_audit_enabled)
+            {
+                if (block == audit_->previous_block)
+                    audit_->previous_block = nullptr;
+                else if (block == audit_->live_block)
+                    audit_->live_block = nullptr;
+            }
+
+            std::allocator<T>{}.deallocate(block, n);
+        }
+
+        template <typename U, typename... TArgs>
+        void construct(U* p, TArgs&&... args)
+        {
+            if constexpr (reallocation_audit_enabled && sizeof...(TArgs) == 1
+                && (std::is_same_v<TArgs, const U&> && ...) && !std::is_nothrow_move_constructible_v<U>)
+            {
+                if ((is_in_previous_block(std::addressof(args)) && ...))
+                    ++audit_->copy_fallbacks;
+            }
+
+            ::new (static_cast<void*>(p)) U(std::forward<TArgs>(args)...);
+        }
+
+        template <typename U>
+        bool operator==(const AuditingAllocator<U>& other) const noexcept
+        {
+            return audit_ == other.audit_;
+        }
+    };
+} // namespace Helpers
+
+#endif
@@ -0,0 +1,305 @@
+#ifndef RELOCATING_VECTOR_HPP
+#define RELOCATING_VECTOR_HPP
+
+#include "relocation.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <initializer_list>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+namespace Helpers
+{
+    // Dynamic array relocating its items on growth & erase
+    //  - trivially relocatable items (see IsTriviallyRelocatable) are moved by memcpy/memmove,
+    //    other items by their move constructors (which must not throw)
+    //  - has the signature of std::vector - can be a template template argument (e.g. of TemplateTemplateParam::Container)
+    template <typename T, typename TAllocator = std::allocator<T>>
+    class RelocatingVector
+    {
+        static_assert(IsTriviallyRelocatable_v<T> || std::is_nothrow_move_constructible_v<T>,
+            "RelocatingVector requires trivially relocatable or nothrow move constructible items");
+
+        using AllocatorTraits = std::allocator_traits<TAllocator>;
+
+        [[no_unique_address]] TAllocator allocator_;
+        T* data_{};
+        std::size_t size_{};
+        std::size_t capacity_{};
+
+        void reallocate(std::size_t new_capacity)
+        {
+            T* new_data = AllocatorTraits::allocate(allocator_, new_capacity);
+            relocate(data_, data_ + size_, new_data);
+
+            if (data_)
+                AllocatorTraits::deallocate(allocator_, data_, capacity_);
+
+            data_ = new_data;
+            capacity_ = new_capacity;
+        }
+
+        void grow_for_one_more()
+        {
+            if (size_ == capacity_)
+                reallocate(capacity_ == 0 ? 4 : 2 * capacity_);
+        }
+
+        void release_storage()
+        {
+            clear();
+
+            if (data_)
+                AllocatorTraits::deallocate(allocator_, std::exchange(data_, nullptr), std::exchange(capacity_, 0));
+        }
+
+        // storage of source is taken over - allocators must be equal (or propagated before)
+        void steal_storage(RelocatingVector& source) noexcept
+        {
+            data_ = std::exchange(source.data_, nullptr);
+            size_ = std::exchange(source.size_, 0);
+            capacity_ = std::exchange(source.capacity_, 0);
+        }
+
+    public:
+        using value_type = T;
+        using allocator_type = TAllocator;
+        using size_type = std::size_t;
+        using reference = T&;
+        using const_reference = const T&;
+        using iterator = T*;
+        using const_iterator = const T*;
+
+        RelocatingVector() = default;
+
+        explicit RelocatingVector(const TAllocator& allocator)
+            : allocator_{allocator}
+        { }
+
+        // constructors below delegate to this one - if filling throws, the destructor releases items built so far
+        explicit RelocatingVector(size_type size, const TAllocator& allocator = TAllocator{})
+            : RelocatingVector(allocator)
+        {
+            reserve(size);
+            for (; size_ < size; ++size_)
+                AllocatorTraits::construct(allocator_, data_ + size_);
+        }
+
+        RelocatingVector(std::initializer_list<T> items, const TAllocator& allocator = TAllocator{})
+            : RelocatingVector(allocator)
+        {
+            reserve(items.size());
+            for (const T& item : items)
+                push_back(item);
+        }
+
+        RelocatingVector(const RelocatingVector& source)
+            : RelocatingVector(AllocatorTraits::select_on_container_copy_construction(source.allocator_))
+        {
+            reserve(source.size_);
+            for (const T& item : source)
+                push_back(item);
+        }
+
+        // allocators are propagated as by std::vector (propagate_on_container_copy_assignment, ..._move_assignment, ..._swap)
+        RelocatingVector& operator=(const RelocatingVector& source)
+        {
+            if (this != &source)
+            {
+                if constexpr (AllocatorTraits::propagate_on_container_copy_assignment::value)
+                {
+                    if (allocator_ != source.allocator_)
+                        release_storage();
+
+                    allocator_ = source.allocator_;
+                }
+
+                clear();
+                reserve(source.size_);
+                for (const T& item : source)
+                    push_back(item);
+            }
+
+            return *this;
+        }
+
+        RelocatingVector(RelocatingVector&& source) noexcept
+            : allocator_{std::move(source.allocator_)}
+        {
+            steal_storage(source);
+        }
+
+        // items are moved one by one when allocators differ & are not propagated (e.g. std::pmr::polymorphic_allocator)
+        RelocatingVector& operator=(RelocatingVector&& source) noexcept(
+            AllocatorTraits::propagate_on_container_move_assignment::value || AllocatorTraits::is_always_equal::value)
+        {
+            if (this == &source)
+                return *this;
+
+            if constexpr (AllocatorTraits::propagate_on_container_move_assignment::value)
+            {
+                release_storage();
+                allocator_ = std::move(source.allocator_);
+                steal_storage(source);
+            }
+            else if (allocator_ == source.allocator_)
+            {
+                release_storage();
+                steal_storage(source);
+            }
+            else
+            {
+                clear();
+                reserve(source.size_);
+                for (T& item : source)
+                    emplace_back(std::move(item));
+
+                source.clear();
+            }
+
+            return *this;
+        }
+
+        ~RelocatingVector()
+        {
+            release_storage();
+        }
+
+        // without propagate_on_container_swap allocators must be equal - as for std::vector
+        void swap(RelocatingVector& other) noexcept
+        {
+            if constexpr (AllocatorTraits::propagate_on_container_swap::value)
+            {
+                using std::swap;
+                swap(allocator_, other.allocator_);
+            }
+            else
+                assert(allocator_ == other.allocator_);
+
+            std::swap(data_, other.data_);
+            std::swap(size_, other.size_);
+            std::swap(capacity_, other.capacity_);
+        }
+
+        allocator_type get_allocator() const
+        {
+            return allocator_;
+        }
+
+        bool empty() const
+        {
+            return size_ == 0;
+        }
+
+        size_type size() const
+        {
+            return size_;
+        }
+
+        size_type capacity() const
+        {
+            return capacity_;
+        }
+
+        void reserve(size_type new_capacity)
+        {
+            if (new_capacity > capacity_)
+                reallocate(new_capacity);
+        }
+
+        template <typename... TArgs>
+        reference emplace_back(TArgs&&... args)
+        {
+            if (size_ == capacity_) // args may refer to an item of this vector - construct before relocation
+            {
+                T item(std::forward<TArgs>(args)...);
+                grow_for_one_more();
+                AllocatorTraits::construct(allocator_, data_ + size_, std::move(item));
+            }
+            else
+                AllocatorTraits::construct(allocator_, data_ + size_, std::forward<TArgs>(args)...);
+
+            return data_[size_++];
+        }
+
+        void push_back(const T& item)
+        {
+            emplace_back(item);
+        }
+
+        void push_back(T&& item)
+        {
+            emplace_back(std::move(item));
+        }
+
+        void pop_back()
+        {
+            assert(!empty());
+            AllocatorTraits::destroy(allocator_, data_ + --size_);
+        }
+
+        iterator erase(const_iterator position)
+        {
+            assert(begin() <= position && position < end());
+
+            T* item = data_ + (position - data_);
+            relocate_erase(item, data_ + size_);
+            --size_;
+
+            return item;
+        }
+
+        void clear()
+        {
+            std::destroy(data_, data_ + size_);
+            size_ = 0;
+        }
+
+        reference operator[](size_type index)
+        {
+            assert(index < size_);
+            return data_[index];
+        }
+
+        const_reference operator[](size_type index) const
+        {
+            assert(index < size_);
+            return data_[index];
+        }
+
+        T* data()
+        {
+            return data_;
+        }
+
+        const T* data() const
+        {
+            return data_;
+        }
+
+        iterator begin()
+        {
+            return data_;
+        }
+
+        iterator end()
+        {
+            return data_ + size_;
+        }
+
+        const_iterator begin() const
+        {
+            return data_;
+        }
+
+        const_iterator end() const
+        {
+            return data_ + size_;
+        }
+    };
+} // namespace Helpers
+
+#endif
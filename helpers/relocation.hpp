@@ -0,0 +1,89 @@
+#ifndef RELOCATION_HPP
+#define RELOCATION_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <type_traits>
+
+namespace Helpers
+{
+    ////////////////////////////////////////////////////////
+    // IsTriviallyRelocatable - moving an object to new memory & destroying the source
+    // is equivalent to memcpy of its bytes (the old bytes are then treated as raw memory)
+    //  - true for trivially copyable types
+    //  - opt-in for other types by specialization, e.g.:
+    //      template <>
+    //      struct Helpers::IsTriviallyRelocatable<Paragraph> : std::true_type
+    //      {};
+    //  - NOT true for types pointing into themselves (e.g. libstdc++ std::string with its SSO buffer)
+
+    template <typename T>
+    struct IsTriviallyRelocatable : std::bool_constant<std::is_trivially_copyable_v<T>>
+    {};
+
+    template <typename T>
+    struct IsTriviallyRelocatable<const T> : IsTriviallyRelocatable<T>
+    {};
+
+    template <typename T>
+    struct IsTriviallyRelocatable<std::unique_ptr<T>> : std::true_type
+    {};
+
+    template <typename T>
+    struct IsTriviallyRelocatable<std::shared_ptr<T>> : std::true_type
+    {};
+
+#if defined(_LIBCPP_VERSION)
+    // libc++ strings keep short text inline without a pointer to it
+    template <typename TChar, typename TTraits>
+    struct IsTriviallyRelocatable<std::basic_string<TChar, TTraits, std::allocator<TChar>>> : std::true_type
+    {};
+#endif
+
+    template <typename T>
+    constexpr bool IsTriviallyRelocatable_v = IsTriviallyRelocatable<T>::value;
+
+    // moves [first, last) to uninitialized dest & ends lifetime of the source objects - ranges must not overlap
+    template <typename T>
+    T* relocate(T* first, T* last, T* dest) noexcept
+    {
+        static_assert(IsTriviallyRelocatable_v<T> || std::is_nothrow_move_constructible_v<T>);
+
+        if constexpr (IsTriviallyRelocatable_v<T>)
+        {
+            const std::size_t count = static_cast<std::size_t>(last - first);
+            if (count > 0)
+                std::memcpy(static_cast<void*>(dest), static_cast<const void*>(first), count * sizeof(T));
+
+            return dest + count;
+        }
+        else
+        {
+            T* dest_last = std::uninitialized_move(first, last, dest);
+            std::destroy(first, last);
+
+            return dest_last;
+        }
+    }
+
+    // erases *position from [position, last) - items after it are shifted down by one
+    template <typename T>
+    void relocate_erase(T* position, T* last)
+    {
+        if constexpr (IsTriviallyRelocatable_v<T>)
+        {
+            std::destroy_at(position);
+            std::memmove(static_cast<void*>(position), static_cast<const void*>(position + 1), static_cast<std::size_t>(last - position - 1) * sizeof(T));
+        }
+        else
+        {
+            std::move(position + 1, last, position);
+            std::destroy_at(last - 1);
+        }
+    }
+} // namespace Helpers
+
+#endif
@@ -0,0 +1,209 @@
+#ifndef SLOT_MAP_HPP
+#define SLOT_MAP_HPP
+
+#include "handle.hpp"
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <vector>
+
+namespace Helpers
+{
+    // Slot map - O(1) insert, erase & lookup through generational handles
+    // Values are kept densely packed (erase moves the last value into the hole),
+    // so iteration touches only live elements.
+    template <typename T>
+    class SlotMap
+    {
+    public:
+        using Handle = Helpers::Handle<T>;
+        using value_type = T;
+        using iterator = typename std::vector<T>::iterator;
+        using const_iterator = typename std::vector<T>::const_iterator;
+
+    private:
+        static constexpr std::uint32_t no_free_slot = std::numeric_limits<std::uint32_t>::max();
+        static constexpr std::uint32_t retired_generation = std::numeric_limits<std::uint32_t>::max() - 1;
+
+        // generation is odd when the slot is alive, even when it is free
+        struct Slot
+        {
+            std::uint32_t generation;
+            std::uint32_t index; // index in values_ (alive) or next free slot (free)
+        };
+
+        std::vector<Slot> slots_;
+        std::vector<T> values_;
+        std::vector<std::uint32_t> slot_of_value_;
+        std::uint32_t free_head_{no_free_slot};
+
+    public:
+        SlotMap() = default;
+
+        explicit SlotMap(std::size_t capacity)
+        {
+            reserve(capacity);
+        }
+
+        template <typename... TArgs>
+        Handle emplace(TArgs&&... args)
+        {
+            assert(slots_.size() < no_free_slot);
+
+            const bool reuse_slot = free_head_ != no_free_slot;
+            const auto slot_index = reuse_slot ? free_head_ : static_cast<std::uint32_t>(slots_.size());
+            const auto value_index = static_cast<std::uint32_t>(values_.size());
+
+            values_.emplace_back(std::forward<TArgs>(args)...);
+
+            try
+            {
+                slot_of_value_.push_back(slot_index);
+
+                if (!reuse_slot)
+                    slots_.push_back(Slot{0, no_free_slot});
+            }
+            catch (...)
+            {
+                slot_of_value_.resize(value_index);
+                values_.pop_back();
+                throw;
+            }
+
+            Slot& slot = slots_[slot_index];
+
+            if (reuse_slot)
+                free_head_ = slot.index;
+
+            slot.index = value_index;
+            ++slot.generation;
+
+            return Handle{slot_index, slot.generation};
+        }
+
+        Handle insert(const T& value)
+        {
+            return emplace(value);
+        }
+
+        Handle insert(T&& value)
+        {
+            return emplace(std::move(value));
+        }
+
+        // returns false for a stale handle
+        bool erase(Handle h)
+        {
+            if (!contains(h))
+                return false;
+
+            Slot& slot = slots_[h.index()];
+            const std::uint32_t value_index = slot.index;
+            const std::uint32_t last_index = static_cast<std::uint32_t>(values_.size() - 1);
+
+            if (value_index != last_index)
+            {
+                values_[value_index] = std::move(values_[last_index]);
+                slot_of_value_[value_index] = slot_of_value_[last_index];
+                slots_[slot_of_value_[value_index]].index = value_index;
+            }
+
+            values_.pop_back();
+            slot_of_value_.pop_back();
+
+            ++slot.generation;
+            if (slot.generation != retired_generation) // never reuse a slot with exhausted generations
+            {
+                slot.index = free_head_;
+                free_head_ = h.index();
+            }
+
+            return true;
+        }
+
+        bool contains(Handle h) const
+        {
+            return h.index() < slots_.size() && slots_[h.index()].generation == h.generation();
+        }
+
+        // returns nullptr for a stale handle
+        // pointer is invalidated by next emplace/insert/erase
+        T* get(Handle h)
+        {
+            return contains(h) ? &values_[slots_[h.index()].index] : nullptr;
+        }
+
+        const T* get(Handle h) const
+        {
+            return contains(h) ? &values_[slots_[h.index()].index] : nullptr;
+        }
+
+        T& operator[](Handle h)
+        {
+            assert(contains(h));
+            return values_[slots_[h.index()].index];
+        }
+
+        const T& operator[](Handle h) const
+        {
+            assert(contains(h));
+            return values_[slots_[h.index()].index];
+        }
+
+        // handle of a value at given position of dense iteration
+        Handle handle_at(std::size_t position) const
+        {
+            const std::uint32_t slot_index = slot_of_value_[position];
+            return Handle{slot_index, slots_[slot_index].generation};
+        }
+
+        iterator begin()
+        {
+            return values_.begin();
+        }
+
+        iterator end()
+        {
+            return values_.end();
+        }
+
+        const_iterator begin() const
+        {
+            return values_.begin();
+        }
+
+        const_iterator end() const
+        {
+            return values_.end();
+        }
+
+        std::size_t size() const
+        {
+            return values_.size();
+        }
+
+        bool empty() const
+        {
+            return values_.empty();
+        }
+
+        void reserve(std::size_t capacity)
+        {
+            slots_.reserve(capacity);
+            values_.reserve(capacity);
+            slot_of_value_.reserve(capacity);
+        }
+
+        // erases all values but keeps generations - handles issued before clear() stay stale
+        void clear()
+        {
+            while (!values_.empty())
+                erase(handle_at(values_.size() - 1));
+        }
+    };
+} // namespace Helpers
+
+#endif
@@ -0,0 +1,119 @@
+#ifndef SMALL_FUNCTION_HPP
+#define SMALL_FUNCTION_HPP
+
+#include <concepts>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace Helpers
+{
+    template <typename Signature, std::size_t Capacity = 4 * sizeof(void*)>
+    class SmallFunction;
+
+    // Move-only std::function alternative - a callable is always stored inline (never allocates)
+    // Callables larger than Capacity are rejected at compile time.
+    template <typename R, typename... TArgs, std::size_t Capacity>
+    class SmallFunction<R(TArgs...), Capacity>
+    {
+        struct VTable
+        {
+            R (*invoke)(void* storage, TArgs&&... args);
+            void (*move_to)(void* target, void* source) noexcept;
+            void (*destroy)(void* storage) noexcept;
+        };
+
+        template <typename F>
+        static constexpr VTable vtable_for{
+            [](void* storage, TArgs&&... args) -> R {
+                return std::invoke(*static_cast<F*>(storage), std::forward<TArgs>(args)...);
+            },
+            [](void* target, void* source) noexcept {
+                ::new (target) F(std::move(*static_cast<F*>(source)));
+                std::destroy_at(static_cast<F*>(source));
+            },
+            [](void* storage) noexcept {
+                std::destroy_at(static_cast<F*>(storage));
+            }};
+
+        alignas(std::max_align_t) mutable std::byte storage_[Capacity];
+        const VTable* vtable_{};
+
+    public:
+        SmallFunction() noexcept = default;
+
+        SmallFunction(std::nullptr_t) noexcept { }
+
+        template <typename F>
+            requires(!std::same_as<std::remove_cvref_t<F>, SmallFunction>) && std::is_invocable_r_v<R, std::decay_t<F>&, TArgs...>
+        SmallFunction(F&& f)
+        {
+            using Callable = std::decay_t<F>;
+
+            static_assert(sizeof(Callable) <= Capacity, "Callable is too large for inline storage - increase Capacity");
+            static_assert(alignof(Callable) <= alignof(std::max_align_t), "Callable is over-aligned");
+            static_assert(std::is_nothrow_move_constructible_v<Callable>, "Callable must be nothrow move constructible");
+
+            ::new (static_cast<void*>(storage_)) Callable(std::forward<F>(f));
+            vtable_ = &vtable_for<Callable>;
+        }
+
+        SmallFunction(const SmallFunction&) = delete;
+        SmallFunction& operator=(const SmallFunction&) = delete;
+
+        SmallFunction(SmallFunction&& source) noexcept
+            : vtable_{std::exchange(source.vtable_, nullptr)}
+        {
+            if (vtable_)
+                vtable_->move_to(storage_, source.storage_);
+        }
+
+        SmallFunction& operator=(SmallFunction&& source) noexcept
+        {
+            if (this != &source)
+            {
+                reset();
+
+                if (source.vtable_)
+                {
+                    source.vtable_->move_to(storage_, source.storage_);
+                    vtable_ = std::exchange(source.vtable_, nullptr);
+                }
+            }
+
+            return *this;
+        }
+
+        ~SmallFunction()
+        {
+            reset();
+        }
+
+        void reset() noexcept
+        {
+            if (vtable_)
+            {
+                vtable_->destroy(storage_);
+                vtable_ = nullptr;
+            }
+        }
+
+        explicit operator bool() const noexcept
+        {
+            return vtable_ != nullptr;
+        }
+
+        R operator()(TArgs... args) const
+        {
+            if (!vtable_)
+                throw std::bad_function_call{};
+
+            return vtable_->invoke(storage_, std::forward<TArgs>(args)...);
+        }
+    };
+} // namespace Helpers
+
+#endif
@@ -0,0 +1,229 @@
+#define ENABLE_MOVE_SEMANTICS
+#include "helpers.hpp"
+#include "memory_resources.hpp"
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <new>
+
+namespace
+{
+    // counts allocations passed to upstream
+    class CountingResource : public std::pmr::memory_resource
+    {
+        std::pmr::memory_resource* upstream_;
+
+    public:
+        int allocation_count{};
+        int deallocation_count{};
+
+        explicit CountingResource(std::pmr::memory_resource* upstream = std::pmr::new_delete_resource())
+            : upstream_{upstream}
+        { }
+
+    protected:
+        void* do_allocate(std::size_t bytes, std::size_t alignment) override
+        {
+            ++allocation_count;
+            return upstream_->allocate(bytes, alignment);
+        }
+
+        void do_deallocate(void* p, std::size_t bytes, std::size_t alignment) override
+        {
+            ++deallocation_count;
+            upstream_->deallocate(p, bytes, alignment);
+        }
+
+        bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override
+        {
+            return this == &other;
+        }
+    };
+
+    bool is_aligned(const void* p, std::size_t alignment)
+    {
+        return reinterpret_cast<std::uintptr_t>(p) % alignment == 0;
+    }
+
+    // create_and_fill workload - vector of strings created & destroyed by every request
+    template <typename TVector>
+    std::size_t create_and_fill(TVector vec, int size)
+    {
+        Helpers::String str = "#";
+
+        for (int i = 0; i < size; ++i)
+        {
+            vec.push_back(str);
+            vec.push_back("text");
+        }
+
+        return vec.size();
+    }
+} // namespace
+
+TEST_CASE("Helpers::pmr::Vector - allocates from memory resource", "[pmr]")
+{
+    CountingResource resource;
+
+    {
+        Helpers::pmr::Vector vec{&resource};
+        vec.push_back("text1");
+        vec.push_back("text2");
+
+        REQUIRE(vec.get_allocator().resource() == &resource);
+        REQUIRE(resource.allocation_count >= 1);
+    }
+
+    REQUIRE(resource.deallocation_count == resource.allocation_count);
+}
+
+TEST_CASE("StackBufferResource", "[pmr]")
+{
+    CountingResource upstream;
+    Helpers::StackBufferResource<4096> arena{&upstream};
+
+    SECTION("small containers use the inline buffer only")
+    {
+        Helpers::pmr::Vector vec{&arena};
+        vec.reserve(16);
+        for (int i = 0; i < 16; ++i)
+            vec.push_back("item");
+
+        REQUIRE(upstream.allocation_count == 0);
+    }
+
+    SECTION("exhausted buffer takes memory from upstream")
+    {
+        Helpers::pmr::Vector vec{&arena};
+        vec.reserve(2 * arena.buffer_size() / sizeof(Helpers::String));
+
+        REQUIRE(upstream.allocation_count == 1);
+
+        arena.release();
+        REQUIRE(upstream.deallocation_count == 1);
+    }
+
+    SECTION("without upstream an exhausted buffer throws")
+    {
+        Helpers::StackBufferResource<256> small_arena{std::pmr::null_memory_resource()};
+        Helpers::pmr::Vector vec{&small_arena};
+
+        REQUIRE_THROWS_AS(vec.reserve(1000), std::bad_alloc);
+    }
+}
+
+TEST_CASE("UnsynchronizedPoolResource - reuses released blocks", "[pmr]")
+{
+    CountingResource upstream;
+    Helpers::UnsynchronizedPoolResource pool{&upstream};
+
+    auto handle_request = [&pool] {
+        Helpers::pmr::Vector vec{&pool};
+        vec.reserve(8);
+        vec.push_back("text");
+    };
+
+    handle_request();
+    const int allocation_count = upstream.allocation_count; // chunk of blocks & pool bookkeeping
+
+    for (int request = 0; request < 100; ++request)
+        handle_request();
+
+    REQUIRE(upstream.allocation_count == allocation_count);
+}
+
+TEST_CASE("HugePageResource - page aligned memory", "[pmr]")
+{
+    std::pmr::memory_resource* resource = Helpers::huge_page_resource();
+
+    SECTION("small allocation - regular page")
+    {
+        void* p = resource->allocate(100, alignof(std::max_align_t));
+        REQUIRE(is_aligned(p, Helpers::HugePageResource::page_size()));
+
+        static_cast<std::byte*>(p)[99] = std::byte{1};
+        resource->deallocate(p, 100, alignof(std::max_align_t));
+    }
+
+    SECTION("large allocation - huge page")
+    {
+        constexpr std::size_t size = 3 * Helpers::HugePageResource::huge_page_size + 1;
+
+        void* p = resource->allocate(size, alignof(std::max_align_t));
+        REQUIRE(is_aligned(p, Helpers::HugePageResource::huge_page_size));
+
+        static_cast<std::byte*>(p)[size - 1] = std::byte{1};
+        resource->deallocate(p, size, alignof(std::max_align_t));
+    }
+
+    SECTION("alignment stricter than a page - mapping is rounded up")
+    {
+        const std::size_t alignment = 16 * Helpers::HugePageResource::page_size();
+
+        void* p = resource->allocate(100, alignment);
+        REQUIRE(is_aligned(p, alignment));
+
+        static_cast<std::byte*>(p)[99] = std::byte{1};
+        resource->deallocate(p, 100, alignment);
+    }
+
+    SECTION("upstream of an arena")
+    {
+        std::pmr::monotonic_buffer_resource arena{Helpers::HugePageResource::huge_page_size, resource};
+        Helpers::pmr::Vector vec{&arena};
+
+        for (int i = 0; i < 1000; ++i)
+            vec.push_back("text");
+
+        REQUIRE(vec.size() == 1000);
+    }
+}
+
+TEST_CASE("create_and_fill - memory resources", "[.benchmark]")
+{
+    constexpr int size = 100;
+
+    Helpers::UnsynchronizedPoolResource pool;
+    Helpers::UnsynchronizedPoolResource huge_page_pool{Helpers::huge_page_resource()};
+
+    // buffer of per-request arenas - allocated once, reused by every request
+    constexpr std::size_t arena_size = Helpers::HugePageResource::huge_page_size;
+    void* arena_buffer = Helpers::huge_page_resource()->allocate(arena_size);
+
+    BENCHMARK("std::allocator")
+    {
+        return create_and_fill(Helpers::Vector{}, size);
+    };
+
+    BENCHMARK("new_delete_resource")
+    {
+        return create_and_fill(Helpers::pmr::Vector{std::pmr::new_delete_resource()}, size);
+    };
+
+    BENCHMARK("StackBufferResource - per request")
+    {
+        Helpers::StackBufferResource<64 * 1024> arena;
+        return create_and_fill(Helpers::pmr::Vector{&arena}, size);
+    };
+
+    BENCHMARK("UnsynchronizedPoolResource")
+    {
+        return create_and_fill(Helpers::pmr::Vector{&pool}, size);
+    };
+
+    BENCHMARK("UnsynchronizedPoolResource - upstream: HugePageResource")
+    {
+        return create_and_fill(Helpers::pmr::Vector{&huge_page_pool}, size);
+    };
+
+    BENCHMARK("monotonic arena on a huge page - per request")
+    {
+        std::pmr::monotonic_buffer_resource arena{arena_buffer, arena_size, Helpers::huge_page_resource()};
+        return create_and_fill(Helpers::pmr::Vector{&arena}, size);
+    };
+
+    Helpers::huge_page_resource()->deallocate(arena_buffer, arena_size);
+}
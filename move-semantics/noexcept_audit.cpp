@@ -0,0 +1,131 @@
+#define ENABLE_MOVE_SEMANTICS
+#include "gadget.hpp"
+#include "graph_arena.hpp"
+#include "handle.hpp"
+#include "helpers.hpp"
+#include "memory_resources.hpp"
+#include "noexcept_audit.hpp"
+#include "relocating_vector.hpp"
+#include "slot_map.hpp"
+#include "small_function.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+using Helpers::MemberGuarantee;
+using Helpers::SpecialMembers;
+
+namespace
+{
+    // move constructor without noexcept - std::vector copies it on reallocation
+    struct ThrowingMove
+    {
+        std::string value;
+
+        ThrowingMove(std::string v)
+            : value{std::move(v)}
+        { }
+
+        ThrowingMove(const ThrowingMove&) = default;
+        ThrowingMove& operator=(const ThrowingMove&) = default;
+
+        ThrowingMove(ThrowingMove&& source)
+            : value{std::move(source.value)}
+        { }
+
+        ThrowingMove& operator=(ThrowingMove&&) = default;
+    };
+
+    template <typename T>
+    Helpers::ReallocationAudit audit_push_back(int count)
+    {
+        Helpers::ReallocationAudit audit;
+
+        {
+            std::vector<T, Helpers::AuditingAllocator<T>> vec{Helpers::AuditingAllocator<T>{audit}};
+            for (int i = 0; i < count; ++i)
+                vec.push_back(T{std::to_string(i)});
+        }
+
+        return audit;
+    }
+} // namespace
+
+TEST_CASE("special members - report")
+{
+    using Members = SpecialMembers<ThrowingMove>;
+
+    static_assert(Members::default_constructor == MemberGuarantee::deleted);
+    static_assert(Members::copy_constructor == MemberGuarantee::may_throw);
+    static_assert(Members::move_constructor == MemberGuarantee::may_throw);
+    static_assert(Members::move_assignment == MemberGuarantee::nothrow);
+    static_assert(!Members::is_moved_on_reallocation);
+
+    static_assert(SpecialMembers<int>::move_constructor == MemberGuarantee::trivial);
+    static_assert(SpecialMembers<std::unique_ptr<int>>::is_moved_on_reallocation);
+
+    Helpers::print_special_members<ThrowingMove>("ThrowingMove");
+}
+
+TEST_CASE("special members - Helpers")
+{
+    static_assert(Helpers::assert_nothrow_movable<Helpers::String>());
+    static_assert(Helpers::assert_nothrow_movable<Helpers::Gadget>());
+    static_assert(Helpers::assert_nothrow_movable<Helpers::Vector>());
+    static_assert(Helpers::assert_nothrow_movable<Helpers::RelocatingVector<Helpers::String>>());
+    static_assert(Helpers::assert_nothrow_movable<Helpers::SlotMap<std::string>>());
+    static_assert(Helpers::assert_nothrow_movable<Helpers::GraphArena<std::string>>());
+    static_assert(Helpers::assert_nothrow_movable<Helpers::SmallFunction<void()>>());
+
+    // allocators of a moved-to vector may differ - elements are then moved one by one
+    static_assert(SpecialMembers<Helpers::pmr::Vector>::move_constructor == MemberGuarantee::nothrow);
+    static_assert(SpecialMembers<Helpers::pmr::Vector>::move_assignment == MemberGuarantee::may_throw);
+
+    static_assert(SpecialMembers<Helpers::Handle<int>>::copy_constructor == MemberGuarantee::trivial);
+    static_assert(SpecialMembers<Helpers::Handle<int>>::destructor == MemberGuarantee::trivial);
+
+    // memory resources are referenced by containers - not movable
+    static_assert(SpecialMembers<Helpers::StackBufferResource<64>>::move_constructor == MemberGuarantee::deleted);
+    static_assert(SpecialMembers<Helpers::UnsynchronizedPoolResource>::move_constructor == MemberGuarantee::deleted);
+    static_assert(SpecialMembers<Helpers::HugePageResource>::move_constructor == MemberGuarantee::nothrow); // stateless
+}
+
+TEST_CASE("reallocation audit - copy fallback of std::vector")
+{
+    SECTION("noexcept move - items are moved")
+    {
+        Helpers::ReallocationAudit audit = audit_push_back<Helpers::String>(100);
+
+        REQUIRE(audit.copy_fallbacks == 0);
+    }
+
+    SECTION("throwing move - items are copied")
+    {
+        Helpers::ReallocationAudit audit = audit_push_back<ThrowingMove>(100);
+
+        if constexpr (Helpers::reallocation_audit_enabled)
+        {
+            REQUIRE(audit.reallocations > 0);
+            REQUIRE(audit.copy_fallbacks >= 99); // every item existing at a reallocation
+        }
+        else
+            REQUIRE(audit.copy_fallbacks == 0);
+    }
+
+    SECTION("copy of an item outside the container is not a fallback")
+    {
+        Helpers::ReallocationAudit audit;
+        const ThrowingMove item{"text"};
+
+        std::vector<ThrowingMove, Helpers::AuditingAllocator<ThrowingMove>> vec{Helpers::AuditingAllocator<ThrowingMove>{audit}};
+        vec.reserve(4);
+        for (int i = 0; i < 4; ++i)
+            vec.push_back(item);
+
+        REQUIRE(audit.reallocations == 0);
+        REQUIRE(audit.copy_fallbacks == 0);
+    }
+}
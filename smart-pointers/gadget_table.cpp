@@ -0,0 +1,102 @@
+#include "gadget_table.hpp"
+
+#include <algorithm>
+#include <catch2/catch_test_macros.hpp>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using Helpers::GadgetTable;
+
+TEST_CASE("GadgetTable - create")
+{
+    GadgetTable gadgets(3);
+
+    REQUIRE(gadgets.size() == 3);
+    REQUIRE(std::ranges::equal(gadgets.ids(), std::vector{0, 1, 2}));
+
+    SECTION("appended gadgets get ids of their positions")
+    {
+        gadgets.create(2);
+
+        REQUIRE(gadgets.size() == 5);
+        REQUIRE(std::ranges::equal(gadgets.ids(), std::vector{0, 1, 2, 3, 4}));
+    }
+
+    SECTION("empty table")
+    {
+        GadgetTable empty_table;
+
+        REQUIRE(empty_table.empty());
+        REQUIRE(empty_table.ids().empty());
+    }
+}
+
+TEST_CASE("GadgetTable - ids")
+{
+    GadgetTable gadgets(4);
+
+    SECTION("reset_ids")
+    {
+        gadgets.reset_ids(100);
+        REQUIRE(std::ranges::equal(gadgets.ids(), std::vector{100, 101, 102, 103}));
+    }
+
+    SECTION("for_each_id")
+    {
+        int sum = 0;
+        gadgets.for_each_id([&sum](int id) { sum += id; });
+
+        REQUIRE(sum == 6);
+    }
+}
+
+TEST_CASE("GadgetTable - names")
+{
+    GadgetTable gadgets(3);
+
+    REQUIRE(gadgets.name(1).empty()); // no names allocated yet
+
+    gadgets.set_name(1, "ipad");
+    gadgets.set_name(2, "smartwatch");
+
+    REQUIRE(gadgets.name(0).empty());
+    REQUIRE(gadgets.name(1) == "ipad");
+    REQUIRE(gadgets.name(2) == "smartwatch");
+
+    SECTION("name is replaced")
+    {
+        gadgets.set_name(1, "ipod");
+        REQUIRE(gadgets.name(1) == "ipod");
+        REQUIRE(gadgets.name(2) == "smartwatch");
+    }
+
+    SECTION("gadgets created later have no names")
+    {
+        gadgets.create(2);
+
+        REQUIRE(gadgets.name(4).empty());
+        REQUIRE(gadgets.name(2) == "smartwatch");
+    }
+}
+
+TEST_CASE("GadgetRef - view of a row")
+{
+    GadgetTable gadgets(2);
+
+    GadgetTable::GadgetRef gadget = gadgets[1];
+    REQUIRE(gadget.id() == 1);
+
+    gadget.set_id(42);
+    gadget.set_name("mp3 player");
+
+    REQUIRE(gadgets.id(1) == 42);
+    REQUIRE(gadgets.name(1) == "mp3 player");
+    REQUIRE(gadgets[1].name() == "mp3 player");
+    REQUIRE(gadgets.id(0) == 0);
+
+    gadgets.create(100); // a row view stays valid after growth - it holds an index
+    REQUIRE(gadget.id() == 42);
+
+    REQUIRE_THROWS_AS(gadget.unsafe(), std::runtime_error);
+}
@@ -0,0 +1,289 @@
+#include "graph_arena.hpp"
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using Helpers::GraphArena;
+using Helpers::Handle;
+
+namespace Arena
+{
+    class Human
+    {
+    public:
+        inline static int alive_count{};
+
+        Human(const std::string& name)
+            : name_(name)
+        {
+            ++alive_count;
+            std::cout << "Constructor Human(" << name_ << ")" << std::endl;
+        }
+
+        Human(Human&& source) noexcept
+            : partner_{source.partner_}
+            , name_{std::move(source.name_)}
+        {
+            ++alive_count;
+        }
+
+        Human& operator=(Human&&) = delete;
+
+        ~Human()
+        {
+            --alive_count;
+
+            if (!name_.empty())
+                std::cout << "Destructor ~Human(" << name_ << ")" << std::endl;
+        }
+
+        void set_partner(Handle<Human> partner)
+        {
+            partner_ = partner;
+        }
+
+        const std::string& name() const
+        {
+            return name_;
+        }
+
+        void description(const GraphArena<Human>& arena) const
+        {
+            std::cout << "My name is " << name_ << std::endl;
+
+            if (const Human* partner = arena.get(partner_))
+            {
+                std::cout << "My partner is " << partner->name_ << std::endl;
+            }
+        }
+
+    private:
+        Handle<Human> partner_;
+        std::string name_;
+    };
+} // namespace Arena
+
+TEST_CASE("GraphArena - circular dependency without leaks")
+{
+    using Arena::Human;
+
+    {
+        GraphArena<Human> arena;
+
+        auto husband = arena.create("Jan");
+        auto wife = arena.create("Ewa");
+
+        arena[husband].set_partner(wife);
+        arena[wife].set_partner(husband);
+
+        arena[husband].description(arena);
+
+        REQUIRE(arena.size() == 2);
+        REQUIRE(Human::alive_count == 2);
+    } // whole graph released with the arena
+
+    REQUIRE(Human::alive_count == 0);
+}
+
+TEST_CASE("GraphArena - handles")
+{
+    GraphArena<std::string> arena;
+
+    auto h1 = arena.create("one");
+    auto h2 = arena.create("two");
+
+    SECTION("default constructed handle is null")
+    {
+        Handle<std::string> h;
+
+        REQUIRE_FALSE(h);
+        REQUIRE_FALSE(arena.contains(h));
+        REQUIRE(arena.get(h) == nullptr);
+    }
+
+    SECTION("valid handle gives access to a node")
+    {
+        REQUIRE(arena.contains(h1));
+        REQUIRE(*arena.get(h2) == "two");
+        REQUIRE(arena[h1] == "one");
+    }
+
+    SECTION("destroyed node makes a handle stale")
+    {
+        arena.destroy(h1);
+
+        REQUIRE(arena.size() == 1);
+        REQUIRE_FALSE(arena.contains(h1));
+        REQUIRE(arena.get(h1) == nullptr);
+
+        SECTION("slot is reused with a new generation")
+        {
+            auto h3 = arena.create("three");
+
+            REQUIRE(h3.index() == h1.index());
+            REQUIRE(h3.generation() != h1.generation());
+            REQUIRE(arena.get(h1) == nullptr);
+            REQUIRE(arena[h3] == "three");
+        }
+    }
+
+    SECTION("throwing constructor leaves the arena unchanged")
+    {
+        const std::size_t too_long = std::string{}.max_size() + 1;
+
+        SECTION("new slot")
+        {
+            REQUIRE_THROWS_AS(arena.create(too_long, '*'), std::length_error);
+
+            REQUIRE(arena.size() == 2);
+            REQUIRE(arena.create("three").index() == 2);
+        }
+
+        SECTION("reused slot")
+        {
+            arena.destroy(h1);
+            REQUIRE_THROWS_AS(arena.create(too_long, '*'), std::length_error);
+
+            REQUIRE(arena.size() == 1);
+            REQUIRE(arena.create("three").index() == h1.index()); // still on the free list
+        }
+    }
+
+    SECTION("clear makes all handles stale")
+    {
+        arena.clear();
+
+        REQUIRE(arena.empty());
+
+        auto h3 = arena.create("three");
+
+        REQUIRE_FALSE(arena.contains(h1));
+        REQUIRE_FALSE(arena.contains(h2));
+        REQUIRE(arena.contains(h3));
+    }
+
+    SECTION("for_each visits alive nodes")
+    {
+        arena.destroy(h1);
+
+        std::vector<std::string> names;
+        arena.for_each([&](Handle<std::string> h, const std::string& name) {
+            REQUIRE(h == h2);
+            names.push_back(name);
+        });
+
+        REQUIRE(names == std::vector<std::string>{"two"});
+    }
+}
+
+namespace Benchmark
+{
+    constexpr int graph_size = 10'000'000;
+
+    struct SharedPerson
+    {
+        int id;
+        std::weak_ptr<SharedPerson> partner;
+    };
+
+    struct ArenaPerson
+    {
+        int id;
+        Handle<ArenaPerson> partner;
+    };
+
+    std::vector<std::shared_ptr<SharedPerson>> build_shared_graph(int size)
+    {
+        std::vector<std::shared_ptr<SharedPerson>> people;
+        people.reserve(size);
+
+        for (int i = 0; i < size; ++i)
+            people.push_back(std::make_shared<SharedPerson>(i));
+
+        for (int i = 0; i + 1 < size; i += 2)
+        {
+            people[i]->partner = people[i + 1];
+            people[i + 1]->partner = people[i];
+        }
+
+        return people;
+    }
+
+    long long walk(const std::vector<std::shared_ptr<SharedPerson>>& people)
+    {
+        long long sum = 0;
+
+        for (const auto& person : people)
+        {
+            if (auto partner = person->partner.lock())
+                sum += partner->id;
+        }
+
+        return sum;
+    }
+
+    std::pair<GraphArena<ArenaPerson>, std::vector<Handle<ArenaPerson>>> build_arena_graph(int size)
+    {
+        GraphArena<ArenaPerson> arena(size);
+        std::vector<Handle<ArenaPerson>> people;
+        people.reserve(size);
+
+        for (int i = 0; i < size; ++i)
+            people.push_back(arena.create(i));
+
+        for (int i = 0; i + 1 < size; i += 2)
+        {
+            arena[people[i]].partner = people[i + 1];
+            arena[people[i + 1]].partner = people[i];
+        }
+
+        return {std::move(arena), std::move(people)};
+    }
+
+    long long walk(const GraphArena<ArenaPerson>& arena, const std::vector<Handle<ArenaPerson>>& people)
+    {
+        long long sum = 0;
+
+        for (auto person : people)
+        {
+            if (const ArenaPerson* partner = arena.get(arena[person].partner))
+                sum += partner->id;
+        }
+
+        return sum;
+    }
+} // namespace Benchmark
+
+TEST_CASE("GraphArena vs shared_ptr/weak_ptr - 10M node social graph", "[.benchmark]")
+{
+    using namespace Benchmark;
+
+    BENCHMARK("shared_ptr/weak_ptr - build")
+    {
+        return build_shared_graph(graph_size).size();
+    };
+
+    BENCHMARK("GraphArena - build")
+    {
+        return build_arena_graph(graph_size).first.size();
+    };
+
+    auto shared_graph = build_shared_graph(graph_size);
+    auto arena_graph = build_arena_graph(graph_size);
+    REQUIRE(walk(shared_graph) == walk(arena_graph.first, arena_graph.second));
+
+    BENCHMARK("shared_ptr/weak_ptr - walk")
+    {
+        return walk(shared_graph);
+    };
+
+    BENCHMARK("GraphArena - walk")
+    {
+        return walk(arena_graph.first, arena_graph.second);
+    };
+}
@@ -0,0 +1,90 @@
+#include "slot_map.hpp"
+
+#include <algorithm>
+#include <catch2/catch_test_macros.hpp>
+#include <memory>
+#include <string>
+#include <vector>
+
+using Helpers::SlotMap;
+
+TEST_CASE("SlotMap - insert & lookup")
+{
+    SlotMap<std::string> slot_map;
+
+    auto h1 = slot_map.insert("one");
+    auto h2 = slot_map.emplace(3, '*');
+
+    REQUIRE(slot_map.size() == 2);
+    REQUIRE(slot_map[h1] == "one");
+    REQUIRE(*slot_map.get(h2) == "***");
+
+    SECTION("null handle is never valid")
+    {
+        REQUIRE_FALSE(slot_map.contains(SlotMap<std::string>::Handle{}));
+    }
+}
+
+TEST_CASE("SlotMap - erase")
+{
+    SlotMap<std::string> slot_map;
+
+    auto h1 = slot_map.insert("one");
+    auto h2 = slot_map.insert("two");
+    auto h3 = slot_map.insert("three");
+
+    REQUIRE(slot_map.erase(h1));
+
+    SECTION("handle becomes stale")
+    {
+        REQUIRE_FALSE(slot_map.contains(h1));
+        REQUIRE(slot_map.get(h1) == nullptr);
+        REQUIRE_FALSE(slot_map.erase(h1));
+    }
+
+    SECTION("other handles stay valid")
+    {
+        REQUIRE(slot_map[h2] == "two");
+        REQUIRE(slot_map[h3] == "three");
+    }
+
+    SECTION("values stay densely packed")
+    {
+        REQUIRE(slot_map.size() == 2);
+
+        std::vector<std::string> values(slot_map.begin(), slot_map.end());
+        std::sort(values.begin(), values.end());
+        REQUIRE(values == std::vector<std::string>{"three", "two"});
+    }
+
+    SECTION("reused slot does not revive stale handle")
+    {
+        auto h4 = slot_map.insert("four");
+
+        REQUIRE(h4.index() == h1.index());
+        REQUIRE_FALSE(slot_map.contains(h1));
+        REQUIRE(slot_map[h4] == "four");
+    }
+
+    SECTION("clear makes all handles stale")
+    {
+        slot_map.clear();
+
+        REQUIRE(slot_map.empty());
+        REQUIRE_FALSE(slot_map.contains(h2));
+        REQUIRE_FALSE(slot_map.contains(h3));
+    }
+}
+
+TEST_CASE("SlotMap - move-only values")
+{
+    SlotMap<std::unique_ptr<int>> slot_map;
+
+    auto h1 = slot_map.insert(std::make_unique<int>(1));
+    auto h2 = slot_map.insert(std::make_unique<int>(2));
+
+    slot_map.erase(h1);
+
+    REQUIRE(*slot_map[h2] == 2);
+    REQUIRE(slot_map.handle_at(0) == h2);
+}
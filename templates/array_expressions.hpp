@@ -0,0 +1,186 @@
+#ifndef ARRAY_EXPRESSIONS_HPP
+#define ARRAY_EXPRESSIONS_HPP
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <concepts>
+#include <cstddef>
+#include <functional>
+#include <type_traits>
+#include <utility>
+
+// Expression templates for fixed-size arrays
+//  - b * 2 + c - d builds a tree of lightweight nodes (no temporaries), assign() evaluates it in one fused loop
+//  - an operand is any type with value_type, static extent & operator[] (e.g. Array<T, N>)
+//  - loops for extent <= unroll_limit are unrolled at compile time
+namespace ArrayExpressions
+{
+    inline constexpr std::size_t unroll_limit = 16;
+
+    // alignment of storage for N items of T - a whole vector register when it fits in one
+    template <typename T, std::size_t N>
+    inline constexpr std::size_t storage_alignment = std::max(alignof(T), std::min<std::size_t>(64, std::bit_ceil(sizeof(T) * N)));
+
+    template <typename E>
+    concept Operand = requires(const E& e, std::size_t index) {
+        typename E::value_type;
+        { E::extent } -> std::convertible_to<std::size_t>;
+        { e[index] } -> std::convertible_to<typename E::value_type>;
+    };
+
+    template <typename TScalar>
+    concept Scalar = std::is_arithmetic_v<TScalar>;
+
+    template <typename F, std::size_t... Indexes>
+    constexpr void unrolled(F&& f, std::index_sequence<Indexes...>)
+    {
+        (f(Indexes), ...);
+    }
+
+    template <std::size_t N, typename F>
+    constexpr void for_each_index(F&& f)
+    {
+        if constexpr (N <= unroll_limit)
+            unrolled(f, std::make_index_sequence<N>{});
+        else
+        {
+            for (std::size_t i = 0; i < N; ++i)
+                f(i);
+        }
+    }
+
+    template <typename E>
+    struct IsNode : std::false_type
+    { };
+
+    // nodes are held by value (they are temporaries of a full expression), arrays by reference
+    template <typename E>
+    using Stored = std::conditional_t<IsNode<E>::value, const E, const E&>;
+
+    template <Operand TLeft, Operand TRight, typename TOperation>
+        requires(TLeft::extent == TRight::extent)
+    struct Binary
+    {
+        using value_type = std::invoke_result_t<TOperation, typename TLeft::value_type, typename TRight::value_type>;
+        static constexpr std::size_t extent = TLeft::extent;
+
+        Stored<TLeft> lhs;
+        Stored<TRight> rhs;
+
+        constexpr value_type operator[](std::size_t index) const
+        {
+            return TOperation{}(lhs[index], rhs[index]);
+        }
+    };
+
+    template <Operand TLeft, Operand TRight, typename TOperation>
+    struct IsNode<Binary<TLeft, TRight, TOperation>> : std::true_type
+    { };
+
+    // scalar broadcast to every index - keeps its own type, so Array<int, N> * 2.5 has items of double
+    template <Scalar T, std::size_t N>
+    struct Broadcast
+    {
+        using value_type = T;
+        static constexpr std::size_t extent = N;
+
+        T value;
+
+        constexpr value_type operator[](std::size_t) const
+        {
+            return value;
+        }
+    };
+
+    template <Scalar T, std::size_t N>
+    struct IsNode<Broadcast<T, N>> : std::true_type
+    { };
+
+    template <Operand E>
+    struct Negate
+    {
+        using value_type = typename E::value_type;
+        static constexpr std::size_t extent = E::extent;
+
+        Stored<E> operand;
+
+        constexpr value_type operator[](std::size_t index) const
+        {
+            return -operand[index];
+        }
+    };
+
+    template <Operand E>
+    struct IsNode<Negate<E>> : std::true_type
+    { };
+
+    template <typename TOperation, Operand TLeft, Operand TRight>
+        requires(TLeft::extent == TRight::extent)
+    constexpr Binary<TLeft, TRight, TOperation> make_binary(const TLeft& lhs, const TRight& rhs)
+    {
+        return {lhs, rhs};
+    }
+
+#define ARRAY_EXPRESSIONS_OPERATOR(OP, OPERATION)                                                                     \
+    template <Operand TLeft, Operand TRight>                                                                          \
+        requires(TLeft::extent == TRight::extent)                                                                     \
+    constexpr auto operator OP(const TLeft& lhs, const TRight& rhs)                                                   \
+    {                                                                                                                 \
+        return make_binary<OPERATION>(lhs, rhs);                                                                      \
+    }                                                                                                                 \
+                                                                                                                      \
+    template <Operand TLeft, Scalar TRight>                                                                           \
+    constexpr auto operator OP(const TLeft& lhs, TRight rhs)                                                          \
+    {                                                                                                                 \
+        return make_binary<OPERATION>(lhs, Broadcast<TRight, TLeft::extent>{rhs});                                    \
+    }                                                                                                                 \
+                                                                                                                      \
+    template <Scalar TLeft, Operand TRight>                                                                           \
+    constexpr auto operator OP(TLeft lhs, const TRight& rhs)                                                          \
+    {                                                                                                                 \
+        return make_binary<OPERATION>(Broadcast<TLeft, TRight::extent>{lhs}, rhs);                                    \
+    }
+
+    ARRAY_EXPRESSIONS_OPERATOR(+, std::plus<>)
+    ARRAY_EXPRESSIONS_OPERATOR(-, std::minus<>)
+    ARRAY_EXPRESSIONS_OPERATOR(*, std::multiplies<>)
+    ARRAY_EXPRESSIONS_OPERATOR(/, std::divides<>)
+
+#undef ARRAY_EXPRESSIONS_OPERATOR
+
+    template <Operand E>
+    constexpr Negate<E> operator-(const E& operand)
+    {
+        return {operand};
+    }
+
+    // dest[i] = expression[i] - dest may appear in the expression (items are read & written at the same index)
+    template <typename TDest, Operand E>
+        requires(TDest::extent == E::extent)
+    constexpr TDest& assign(TDest& dest, const E& expression)
+    {
+        for_each_index<E::extent>([&](std::size_t i) { dest[i] = expression[i]; });
+        return dest;
+    }
+
+    template <Operand TLeft, Operand TRight>
+        requires(TLeft::extent == TRight::extent)
+    constexpr auto dot(const TLeft& lhs, const TRight& rhs)
+    {
+        using Result = std::common_type_t<typename TLeft::value_type, typename TRight::value_type>;
+
+        Result result{};
+        for_each_index<TLeft::extent>([&](std::size_t i) { result += lhs[i] * rhs[i]; });
+
+        return result;
+    }
+
+    template <Operand E>
+    auto norm(const E& operand)
+    {
+        return std::sqrt(dot(operand, operand));
+    }
+} // namespace ArrayExpressions
+
+#endif
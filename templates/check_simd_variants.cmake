@@ -0,0 +1,28 @@
+# Fails when an object of a SIMD kernels variant defines a weak (COMDAT) symbol of another namespace
+#  - the linker may keep that copy for every caller - e.g. an AVX2 build of std::pair called by the SSE2 variant
+#  - usage: cmake -DNM=<nm> -DOBJECTS=<object>|<object>... -P check_simd_variants.cmake
+string(REPLACE "|" ";" OBJECTS "${OBJECTS}")
+
+foreach(OBJECT IN LISTS OBJECTS)
+  get_filename_component(OBJECT_NAME ${OBJECT} NAME)
+  if(NOT OBJECT_NAME MATCHES "simd_kernels_([a-z0-9]+)")
+    continue()
+  endif()
+
+  # mangled names of SimdKernels::<variant>:: & SimdDispatch::Variants::<variant><T>()
+  set(VARIANT ${CMAKE_MATCH_1})
+  string(LENGTH ${VARIANT} VARIANT_LENGTH)
+  set(OWN_SYMBOLS "11SimdKernels${VARIANT_LENGTH}${VARIANT}|12SimdDispatch8Variants${VARIANT_LENGTH}${VARIANT}I")
+
+  execute_process(COMMAND ${NM} --defined-only ${OBJECT} OUTPUT_VARIABLE SYMBOLS RESULT_VARIABLE RESULT)
+  if(NOT RESULT EQUAL 0)
+    message(FATAL_ERROR "${NM} failed for ${OBJECT}")
+  endif()
+
+  string(REPLACE "\n" ";" SYMBOLS "${SYMBOLS}")
+  foreach(SYMBOL IN LISTS SYMBOLS)
+    if(SYMBOL MATCHES " [WVu] " AND NOT SYMBOL MATCHES "${OWN_SYMBOLS}")
+      message(SEND_ERROR "${OBJECT_NAME}: weak symbol outside the variant namespace: ${SYMBOL}")
+    endif()
+  endforeach()
+endforeach()
@@ -0,0 +1,146 @@
+#ifndef SIMD_DISPATCH_HPP
+#define SIMD_DISPATCH_HPP
+
+#include "cpu_dispatch.hpp"
+#include "simd_kernels.hpp"
+
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+// SimdKernels selected at runtime for the CPU
+//  - simd_kernels_<variant>.cpp compile the kernels for one instruction set each (flags in CMakeLists.txt),
+//    simd_kernels_scalar.cpp the portable ones without intrinsics
+//  - SIMD_DISPATCH_X86_VARIANTS is defined when these variants are built - otherwise kernels
+//    compiled for the flags of the including translation unit are used
+//  - CPP_ADV_SIMD_LEVEL=<scalar|sse2|sse42|avx2|avx512> forces a variant (see Helpers::active_simd_level())
+namespace SimdDispatch
+{
+    // element types with variants built for every instruction set
+#define SIMD_DISPATCH_FOR_EACH_TYPE(MACRO)                                                                        \
+    MACRO(char)                                                                                                   \
+    MACRO(signed char)                                                                                            \
+    MACRO(unsigned char)                                                                                          \
+    MACRO(short)                                                                                                  \
+    MACRO(unsigned short)                                                                                         \
+    MACRO(int)                                                                                                    \
+    MACRO(unsigned int)                                                                                           \
+    MACRO(long)                                                                                                   \
+    MACRO(unsigned long)                                                                                          \
+    MACRO(long long)                                                                                              \
+    MACRO(unsigned long long)                                                                                     \
+    MACRO(float)                                                                                                  \
+    MACRO(double)
+
+    template <typename T>
+    concept Dispatched = std::same_as<T, char> || std::same_as<T, signed char> || std::same_as<T, unsigned char>
+        || std::same_as<T, short> || std::same_as<T, unsigned short> || std::same_as<T, int> || std::same_as<T, unsigned int>
+        || std::same_as<T, long> || std::same_as<T, unsigned long> || std::same_as<T, long long> || std::same_as<T, unsigned long long>
+        || std::same_as<T, float> || std::same_as<T, double>;
+
+#ifdef SIMD_DISPATCH_X86_VARIANTS
+    namespace Variants
+    {
+        template <Dispatched T>
+        const SimdKernels::KernelSet<T>& scalar();
+
+        template <Dispatched T>
+        const SimdKernels::KernelSet<T>& sse2();
+
+        template <Dispatched T>
+        const SimdKernels::KernelSet<T>& sse42();
+
+        template <Dispatched T>
+        const SimdKernels::KernelSet<T>& avx2();
+
+        template <Dispatched T>
+        const SimdKernels::KernelSet<T>& avx512();
+    } // namespace Variants
+
+    template <Dispatched T>
+    const Helpers::DispatchTable<const SimdKernels::KernelSet<T>*>& dispatch_table()
+    {
+        using Helpers::SimdLevel;
+
+        static const Helpers::DispatchTable<const SimdKernels::KernelSet<T>*> table{
+            {SimdLevel::Scalar, &Variants::scalar<T>()},
+            {SimdLevel::Sse2, &Variants::sse2<T>()},
+            {SimdLevel::Sse42, &Variants::sse42<T>()},
+            {SimdLevel::Avx2, &Variants::avx2<T>()},
+            {SimdLevel::Avx512, &Variants::avx512<T>()}};
+
+        return table;
+    }
+#else
+    template <Dispatched T>
+    const Helpers::DispatchTable<const SimdKernels::KernelSet<T>*>& dispatch_table()
+    {
+        static const Helpers::DispatchTable<const SimdKernels::KernelSet<T>*> table{
+            {Helpers::SimdLevel::Scalar, &SimdKernels::kernel_set<T>}};
+
+        return table;
+    }
+#endif
+
+    template <SimdKernels::Vectorizable T>
+    const SimdKernels::KernelSet<T>& kernels()
+    {
+        if constexpr (Dispatched<T>)
+            return *dispatch_table<T>().active();
+        else
+            return SimdKernels::kernel_set<T>; // e.g. char8_t, wchar_t
+    }
+
+    template <SimdKernels::Vectorizable T>
+    const T* find(const T* first, const T* last, T value)
+    {
+        return kernels<T>().find(first, last, value);
+    }
+
+    template <SimdKernels::Vectorizable T>
+    T sum_naive(const T* first, std::size_t size)
+    {
+        return kernels<T>().sum_naive(first, size);
+    }
+
+    template <SimdKernels::Vectorizable T>
+    T sum_pairwise(const T* first, std::size_t size)
+    {
+        return kernels<T>().sum_pairwise(first, size);
+    }
+
+    template <SimdKernels::Vectorizable T>
+        requires std::floating_point<T>
+    T sum_kahan(const T* first, std::size_t size)
+    {
+        return kernels<T>().sum_kahan(first, size);
+    }
+
+    template <SimdKernels::Vectorizable T>
+    T min_of(const T* first, std::size_t size)
+    {
+        return kernels<T>().min_of(first, size);
+    }
+
+    template <SimdKernels::Vectorizable T>
+    T max_of(const T* first, std::size_t size)
+    {
+        return kernels<T>().max_of(first, size);
+    }
+
+    template <SimdKernels::Vectorizable T>
+    std::pair<T, T> minmax_of(const T* first, std::size_t size)
+    {
+        const auto [min, max] = kernels<T>().minmax_of(first, size);
+        return {min, max};
+    }
+
+    template <SimdKernels::Vectorizable T>
+    std::size_t compress(const T* in, std::size_t count, std::uint64_t mask, T* out)
+    {
+        return kernels<T>().compress(in, count, mask, out);
+    }
+} // namespace SimdDispatch
+
+#endif
@@ -0,0 +1,657 @@
+#ifndef SIMD_KERNELS_HPP
+#define SIMD_KERNELS_HPP
+
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+#if defined(__SSE2__) || defined(_M_X64) || defined(__AVX2__) || defined(__AVX512F__)
+#include <immintrin.h>
+#endif
+
+// Kernels for contiguous ranges of arithmetic types
+//  - every instruction set is wrapped in a struct with the same static interface (Sse2, Avx2, Avx512)
+//  - a kernel is a template parametrized by such struct, NativeIsa is the widest one enabled by compiler flags
+//  - kernels live in an inline namespace named after compiler flags, so translation units built
+//    for different instruction sets (see simd_dispatch.hpp) never share an instantiation
+//  - kernels call no inline functions defined outside that namespace (std::pair, std::array::operator[], std::find, ...)
+//    - the linker keeps one copy of such a function, possibly the one compiled with AVX instructions
+//  - SIMD_KERNELS_SCALAR selects the portable variant without intrinsics (see simd_kernels_scalar.cpp)
+#if defined(SIMD_KERNELS_SCALAR)
+#define SIMD_KERNELS_VARIANT scalar
+#elif defined(__AVX512F__) && defined(__AVX512BW__)
+#define SIMD_KERNELS_VARIANT avx512
+#elif defined(__AVX2__)
+#define SIMD_KERNELS_VARIANT avx2
+#elif defined(__SSE4_2__)
+#define SIMD_KERNELS_VARIANT sse42
+#elif defined(__SSE2__) || defined(_M_X64)
+#define SIMD_KERNELS_VARIANT sse2
+#else
+#define SIMD_KERNELS_VARIANT scalar
+#endif
+
+namespace SimdKernels
+{
+    template <typename T>
+    concept Vectorizable = std::is_arithmetic_v<T> && !std::same_as<T, bool>
+        && (sizeof(T) == 1 || sizeof(T) == 2 || sizeof(T) == 4 || sizeof(T) == 8);
+
+    // out of compress() must have room for count + compress_padding<T> items - registers are stored whole
+    template <Vectorizable T>
+    constexpr std::size_t compress_padding = 64 / sizeof(T);
+
+    // result of minmax_of - an aggregate, so variants call no shared inline constructor (unlike std::pair)
+    template <Vectorizable T>
+    struct MinMax
+    {
+        T min;
+        T max;
+    };
+
+    // kernels of one variant - dispatched at runtime
+    template <Vectorizable T>
+    struct KernelSet
+    {
+        const T* (*find)(const T* first, const T* last, T value);
+        T (*sum_naive)(const T* first, std::size_t size);
+        T (*sum_pairwise)(const T* first, std::size_t size);
+        T (*sum_kahan)(const T* first, std::size_t size); // sum_naive for integral types
+        T (*min_of)(const T* first, std::size_t size);
+        T (*max_of)(const T* first, std::size_t size);
+        MinMax<T> (*minmax_of)(const T* first, std::size_t size);
+        std::size_t (*compress)(const T* in, std::size_t count, std::uint64_t mask, T* out);
+    };
+
+    inline namespace SIMD_KERNELS_VARIANT
+    {
+        // bit counting local to a variant - out-of-line std::popcount compiled with -mpopcnt could be picked
+        // by the linker for code built for any x86-64
+        inline int count_ones(std::uint64_t bits)
+        {
+#if defined(__GNUC__)
+            return __builtin_popcountll(bits);
+#else
+            return std::popcount(bits);
+#endif
+        }
+
+        inline int count_trailing_zeros(std::uint64_t bits) // bits != 0
+        {
+#if defined(__GNUC__)
+            return __builtin_ctzll(bits);
+#else
+            return std::countr_zero(bits);
+#endif
+        }
+
+#if (defined(__SSE2__) || defined(_M_X64)) && !defined(SIMD_KERNELS_SCALAR)
+#define SIMD_KERNELS_HAS_SSE2
+        struct Sse2
+        {
+            using Register = __m128i;
+
+            static constexpr std::size_t width = 16;
+            static constexpr bool mask_per_byte = true; // equal() returns a bit for each byte
+
+            static Register load(const void* p)
+            {
+                return _mm_loadu_si128(static_cast<const __m128i*>(p));
+            }
+
+            template <Vectorizable T>
+            static Register broadcast(T value)
+            {
+                if constexpr (std::same_as<T, float>)
+                    return _mm_castps_si128(_mm_set1_ps(value));
+                else if constexpr (std::same_as<T, double>)
+                    return _mm_castpd_si128(_mm_set1_pd(value));
+                else if constexpr (sizeof(T) == 1)
+                    return _mm_set1_epi8(static_cast<char>(value));
+                else if constexpr (sizeof(T) == 2)
+                    return _mm_set1_epi16(static_cast<short>(value));
+                else if constexpr (sizeof(T) == 4)
+                    return _mm_set1_epi32(static_cast<int>(value));
+                else
+                    return _mm_set1_epi64x(static_cast<long long>(value));
+            }
+
+            template <Vectorizable T>
+            static std::uint64_t equal(Register a, Register b)
+            {
+                Register result;
+
+                if constexpr (std::same_as<T, float>)
+                    result = _mm_castps_si128(_mm_cmpeq_ps(_mm_castsi128_ps(a), _mm_castsi128_ps(b)));
+                else if constexpr (std::same_as<T, double>)
+                    result = _mm_castpd_si128(_mm_cmpeq_pd(_mm_castsi128_pd(a), _mm_castsi128_pd(b)));
+                else if constexpr (sizeof(T) == 1)
+                    result = _mm_cmpeq_epi8(a, b);
+                else if constexpr (sizeof(T) == 2)
+                    result = _mm_cmpeq_epi16(a, b);
+                else if constexpr (sizeof(T) == 4)
+                    result = _mm_cmpeq_epi32(a, b);
+                else // no 64-bit compare in SSE2 - both 32-bit halves must be equal
+                {
+                    result = _mm_cmpeq_epi32(a, b);
+                    result = _mm_and_si128(result, _mm_shuffle_epi32(result, _MM_SHUFFLE(2, 3, 0, 1)));
+                }
+
+                return static_cast<std::uint32_t>(_mm_movemask_epi8(result));
+            }
+        };
+#endif
+
+#if defined(__AVX2__) && !defined(SIMD_KERNELS_SCALAR)
+#define SIMD_KERNELS_HAS_AVX2
+        struct Avx2
+        {
+            using Register = __m256i;
+
+            static constexpr std::size_t width = 32;
+            static constexpr bool mask_per_byte = true;
+
+            static Register load(const void* p)
+            {
+                return _mm256_loadu_si256(static_cast<const __m256i*>(p));
+            }
+
+            template <Vectorizable T>
+            static Register broadcast(T value)
+            {
+                if constexpr (std::same_as<T, float>)
+                    return _mm256_castps_si256(_mm256_set1_ps(value));
+                else if constexpr (std::same_as<T, double>)
+                    return _mm256_castpd_si256(_mm256_set1_pd(value));
+                else if constexpr (sizeof(T) == 1)
+                    return _mm256_set1_epi8(static_cast<char>(value));
+                else if constexpr (sizeof(T) == 2)
+                    return _mm256_set1_epi16(static_cast<short>(value));
+                else if constexpr (sizeof(T) == 4)
+                    return _mm256_set1_epi32(static_cast<int>(value));
+                else
+                    return _mm256_set1_epi64x(static_cast<long long>(value));
+            }
+
+            template <Vectorizable T>
+            static std::uint64_t equal(Register a, Register b)
+            {
+                Register result;
+
+                if constexpr (std::same_as<T, float>)
+                    result = _mm256_castps_si256(_mm256_cmp_ps(_mm256_castsi256_ps(a), _mm256_castsi256_ps(b), _CMP_EQ_OQ));
+                else if constexpr (std::same_as<T, double>)
+                    result = _mm256_castpd_si256(_mm256_cmp_pd(_mm256_castsi256_pd(a), _mm256_castsi256_pd(b), _CMP_EQ_OQ));
+                else if constexpr (sizeof(T) == 1)
+                    result = _mm256_cmpeq_epi8(a, b);
+                else if constexpr (sizeof(T) == 2)
+                    result = _mm256_cmpeq_epi16(a, b);
+                else if constexpr (sizeof(T) == 4)
+                    result = _mm256_cmpeq_epi32(a, b);
+                else
+                    result = _mm256_cmpeq_epi64(a, b);
+
+                return static_cast<std::uint32_t>(_mm256_movemask_epi8(result));
+            }
+        };
+#endif
+
+#if defined(__AVX512F__) && defined(__AVX512BW__) && !defined(SIMD_KERNELS_SCALAR)
+#define SIMD_KERNELS_HAS_AVX512
+        struct Avx512
+        {
+            using Register = __m512i;
+
+            static constexpr std::size_t width = 64;
+            static constexpr bool mask_per_byte = false; // equal() returns a bit for each element
+
+            static Register load(const void* p)
+            {
+                return _mm512_loadu_si512(p);
+            }
+
+            template <Vectorizable T>
+            static Register broadcast(T value)
+            {
+                if constexpr (std::same_as<T, float>)
+                    return _mm512_castps_si512(_mm512_set1_ps(value));
+                else if constexpr (std::same_as<T, double>)
+                    return _mm512_castpd_si512(_mm512_set1_pd(value));
+                else if constexpr (sizeof(T) == 1)
+                    return _mm512_set1_epi8(static_cast<char>(value));
+                else if constexpr (sizeof(T) == 2)
+                    return _mm512_set1_epi16(static_cast<short>(value));
+                else if constexpr (sizeof(T) == 4)
+                    return _mm512_set1_epi32(static_cast<int>(value));
+                else
+                    return _mm512_set1_epi64(static_cast<long long>(value));
+            }
+
+            template <Vectorizable T>
+            static std::uint64_t equal(Register a, Register b)
+            {
+                if constexpr (std::same_as<T, float>)
+                    return _mm512_cmp_ps_mask(_mm512_castsi512_ps(a), _mm512_castsi512_ps(b), _CMP_EQ_OQ);
+                else if constexpr (std::same_as<T, double>)
+                    return _mm512_cmp_pd_mask(_mm512_castsi512_pd(a), _mm512_castsi512_pd(b), _CMP_EQ_OQ);
+                else if constexpr (sizeof(T) == 1)
+                    return _mm512_cmpeq_epi8_mask(a, b);
+                else if constexpr (sizeof(T) == 2)
+                    return _mm512_cmpeq_epi16_mask(a, b);
+                else if constexpr (sizeof(T) == 4)
+                    return _mm512_cmpeq_epi32_mask(a, b);
+                else
+                    return _mm512_cmpeq_epi64_mask(a, b);
+            }
+        };
+#endif
+
+#if defined(SIMD_KERNELS_HAS_AVX512)
+        using NativeIsa = Avx512;
+#elif defined(SIMD_KERNELS_HAS_AVX2)
+        using NativeIsa = Avx2;
+#elif defined(SIMD_KERNELS_HAS_SSE2)
+        using NativeIsa = Sse2;
+#endif
+
+        // position of the first item equal to value (== semantics: NaN is never found, -0.0 == 0.0)
+        template <typename Isa, Vectorizable T>
+        const T* find_with(const T* first, const T* last, T value)
+        {
+            constexpr std::size_t lanes = Isa::width / sizeof(T);
+            constexpr int mask_shift = Isa::mask_per_byte ? std::countr_zero(sizeof(T)) : 0;
+
+            const auto needle = Isa::broadcast(value);
+
+            // four registers per iteration - one branch for 64-256 bytes
+            for (; static_cast<std::size_t>(last - first) >= 4 * lanes; first += 4 * lanes)
+            {
+                const std::uint64_t masks[4] = {
+                    Isa::template equal<T>(Isa::load(first), needle),
+                    Isa::template equal<T>(Isa::load(first + lanes), needle),
+                    Isa::template equal<T>(Isa::load(first + 2 * lanes), needle),
+                    Isa::template equal<T>(Isa::load(first + 3 * lanes), needle)};
+
+                if ((masks[0] | masks[1] | masks[2] | masks[3]) != 0)
+                {
+                    for (std::size_t i = 0;; ++i)
+                    {
+                        if (masks[i] != 0)
+                            return first + i * lanes + (count_trailing_zeros(masks[i]) >> mask_shift);
+                    }
+                }
+            }
+
+            for (; static_cast<std::size_t>(last - first) >= lanes; first += lanes)
+            {
+                if (const std::uint64_t mask = Isa::template equal<T>(Isa::load(first), needle); mask != 0)
+                    return first + (count_trailing_zeros(mask) >> mask_shift);
+            }
+
+            for (; first != last; ++first)
+            {
+                if (*first == value)
+                    return first;
+            }
+
+            return last;
+        }
+
+        template <Vectorizable T>
+        const T* find(const T* first, const T* last, T value)
+        {
+#ifdef SIMD_KERNELS_HAS_SSE2
+            return find_with<NativeIsa>(first, last, value);
+#else
+            for (; first != last; ++first)
+            {
+                if (*first == value)
+                    return first;
+            }
+
+            return last;
+#endif
+        }
+
+        // independent accumulators - one chain of additions per lane, so loops vectorize
+        // and are not bound by the latency of a single add (reorders additions of floats)
+        template <Vectorizable T>
+#ifdef SIMD_KERNELS_HAS_SSE2
+        constexpr std::size_t accumulator_count = 4 * NativeIsa::width / sizeof(T);
+#else
+        constexpr std::size_t accumulator_count = 4;
+#endif
+
+        template <Vectorizable T>
+        T sum_naive(const T* first, std::size_t size)
+        {
+            constexpr std::size_t lanes = accumulator_count<T>;
+
+            T accumulators[lanes] = {};
+
+            std::size_t i = 0;
+            for (; i + lanes <= size; i += lanes)
+            {
+                for (std::size_t lane = 0; lane < lanes; ++lane)
+                    accumulators[lane] += first[i + lane];
+            }
+
+            for (std::size_t lane = 0; i < size; ++i, ++lane)
+                accumulators[lane] += first[i];
+
+            for (std::size_t width = lanes / 2; width > 0; width /= 2) // tree of lanes
+            {
+                for (std::size_t lane = 0; lane < width; ++lane)
+                    accumulators[lane] += accumulators[lane + width];
+            }
+
+            return accumulators[0];
+        }
+
+        // blocks summed with sum_naive & combined pairwise - error grows with log(size)
+        template <Vectorizable T>
+        T sum_pairwise(const T* first, std::size_t size)
+        {
+            constexpr std::size_t block_size = 8 * accumulator_count<T>;
+
+            if (size <= block_size)
+                return sum_naive(first, size);
+
+            const std::size_t half = (size / 2 + block_size - 1) / block_size * block_size;
+
+            return sum_pairwise(first, half) + sum_pairwise(first + half, size - half);
+        }
+
+        // Kahan summation in every lane - the rounding error of each add is carried to the next one
+        // Note: -ffast-math lets the compiler remove the compensation
+        template <Vectorizable T>
+            requires std::floating_point<T>
+        T sum_kahan(const T* first, std::size_t size)
+        {
+            constexpr std::size_t lanes = accumulator_count<T>;
+
+            T sums[lanes] = {};
+            T compensations[lanes] = {};
+
+            auto add = [](T& sum, T& compensation, T value) {
+                const T y = value - compensation;
+                const T t = sum + y;
+                compensation = (t - sum) - y;
+                sum = t;
+            };
+
+            std::size_t i = 0;
+            for (; i + lanes <= size; i += lanes)
+            {
+                for (std::size_t lane = 0; lane < lanes; ++lane)
+                    add(sums[lane], compensations[lane], first[i + lane]);
+            }
+
+            T sum{};
+            T compensation{};
+
+            for (; i < size; ++i)
+                add(sum, compensation, first[i]);
+
+            for (std::size_t lane = 0; lane < lanes; ++lane)
+            {
+                add(sum, compensation, sums[lane]);
+                add(sum, compensation, -compensations[lane]);
+            }
+
+            return sum;
+        }
+
+        // folds of (a < b) ? b : a and (b < a) ? b : a - branchless, one accumulator per lane
+        //  - lanes start from the first item, so a leading NaN propagates & other NaNs are skipped - as in a serial fold
+        //  - which one of equal items (e.g. 0.0 & -0.0) is returned is unspecified
+        template <Vectorizable T>
+        MinMax<T> minmax_of(const T* first, std::size_t size) // size > 0
+        {
+            constexpr std::size_t lanes = accumulator_count<T>;
+
+            T minimums[lanes];
+            T maximums[lanes];
+            for (T& minimum : minimums)
+                minimum = first[0];
+            for (T& maximum : maximums)
+                maximum = first[0];
+
+            std::size_t i = 0;
+            for (; i + lanes <= size; i += lanes)
+            {
+                for (std::size_t lane = 0; lane < lanes; ++lane)
+                {
+                    const T item = first[i + lane];
+                    minimums[lane] = (item < minimums[lane]) ? item : minimums[lane];
+                    maximums[lane] = (maximums[lane] < item) ? item : maximums[lane];
+                }
+            }
+
+            for (std::size_t lane = 0; i < size; ++i, ++lane)
+            {
+                minimums[lane] = (first[i] < minimums[lane]) ? first[i] : minimums[lane];
+                maximums[lane] = (maximums[lane] < first[i]) ? first[i] : maximums[lane];
+            }
+
+            for (std::size_t lane = 1; lane < lanes; ++lane)
+            {
+                minimums[0] = (minimums[lane] < minimums[0]) ? minimums[lane] : minimums[0];
+                maximums[0] = (maximums[0] < maximums[lane]) ? maximums[lane] : maximums[0];
+            }
+
+            return {minimums[0], maximums[0]};
+        }
+
+        template <Vectorizable T>
+        T max_of(const T* first, std::size_t size) // size > 0
+        {
+            constexpr std::size_t lanes = accumulator_count<T>;
+
+            T maximums[lanes];
+            for (T& maximum : maximums)
+                maximum = first[0];
+
+            std::size_t i = 0;
+            for (; i + lanes <= size; i += lanes)
+            {
+                for (std::size_t lane = 0; lane < lanes; ++lane)
+                    maximums[lane] = (maximums[lane] < first[i + lane]) ? first[i + lane] : maximums[lane];
+            }
+
+            for (std::size_t lane = 0; i < size; ++i, ++lane)
+                maximums[lane] = (maximums[lane] < first[i]) ? first[i] : maximums[lane];
+
+            for (std::size_t lane = 1; lane < lanes; ++lane)
+                maximums[0] = (maximums[0] < maximums[lane]) ? maximums[lane] : maximums[0];
+
+            return maximums[0];
+        }
+
+        template <Vectorizable T>
+        T min_of(const T* first, std::size_t size) // size > 0
+        {
+            constexpr std::size_t lanes = accumulator_count<T>;
+
+            T minimums[lanes];
+            for (T& minimum : minimums)
+                minimum = first[0];
+
+            std::size_t i = 0;
+            for (; i + lanes <= size; i += lanes)
+            {
+                for (std::size_t lane = 0; lane < lanes; ++lane)
+                    minimums[lane] = (first[i + lane] < minimums[lane]) ? first[i + lane] : minimums[lane];
+            }
+
+            for (std::size_t lane = 0; i < size; ++i, ++lane)
+                minimums[lane] = (first[i] < minimums[lane]) ? first[i] : minimums[lane];
+
+            for (std::size_t lane = 1; lane < lanes; ++lane)
+                minimums[0] = (minimums[lane] < minimums[0]) ? minimums[lane] : minimums[0];
+
+            return minimums[0];
+        }
+
+        ///////////////////////////////////////////////////////////////////
+        // stream compaction - copies items selected by a bit mask to the front of out
+
+        // bit i set for flags[i] != 0 (flags hold 0 or 1)
+        inline std::uint64_t mask_of_flags(const std::uint8_t (&flags)[64])
+        {
+#ifdef SIMD_KERNELS_HAS_SSE2
+            const __m128i zero = _mm_setzero_si128();
+
+            std::uint64_t mask = 0;
+            for (int i = 0; i < 4; ++i)
+            {
+                const __m128i selected = _mm_cmpgt_epi8(Sse2::load(flags + 16 * i), zero);
+                mask |= std::uint64_t{static_cast<std::uint16_t>(_mm_movemask_epi8(selected))} << (16 * i);
+            }
+
+            return mask;
+#else
+            std::uint64_t mask = 0;
+            for (int i = 0; i < 64; ++i)
+                mask |= std::uint64_t{flags[i]} << i;
+
+            return mask;
+#endif
+        }
+
+        namespace Details
+        {
+            // for every mask of Lanes bits - indexes of selected lanes moved to the front
+            // (each lane spans IndexesPerLane consecutive indexes: bytes for pshufb, dwords for vpermd)
+            template <typename TIndex, std::size_t Lanes, std::size_t IndexesPerLane>
+            struct CompressTable
+            {
+                TIndex indexes[std::size_t{1} << Lanes][Lanes * IndexesPerLane];
+            };
+
+            template <typename TIndex, std::size_t Lanes, std::size_t IndexesPerLane>
+            constexpr CompressTable<TIndex, Lanes, IndexesPerLane> make_compress_table()
+            {
+                CompressTable<TIndex, Lanes, IndexesPerLane> table{};
+
+                for (std::size_t mask = 0; mask < (std::size_t{1} << Lanes); ++mask)
+                {
+                    std::size_t position = 0;
+
+                    for (std::size_t lane = 0; lane < Lanes; ++lane)
+                    {
+                        if (mask & (std::size_t{1} << lane))
+                        {
+                            for (std::size_t i = 0; i < IndexesPerLane; ++i)
+                                table.indexes[mask][position++] = static_cast<TIndex>(lane * IndexesPerLane + i);
+                        }
+                    }
+                }
+
+                return table;
+            }
+
+            template <typename T>
+            std::size_t compress_scalar(const T* in, std::size_t count, std::uint64_t mask, T* out)
+            {
+                std::size_t selected = 0;
+
+                for (std::size_t i = 0; i < count; ++i) // branchless - every item is written, only selected ones advance
+                {
+                    out[selected] = in[i];
+                    selected += (mask >> i) & 1;
+                }
+
+                return selected;
+            }
+        } // namespace Details
+
+        // count <= 64, bit i of mask selects in[i]
+        template <Vectorizable T>
+        std::size_t compress(const T* in, std::size_t count, std::uint64_t mask, T* out)
+        {
+            if constexpr (sizeof(T) == 4 || sizeof(T) == 8)
+            {
+#if defined(SIMD_KERNELS_HAS_AVX512)
+                constexpr std::size_t lanes = 64 / sizeof(T);
+                constexpr std::uint64_t lanes_mask = (std::uint64_t{1} << lanes) - 1;
+
+                T* const out_start = out;
+                std::size_t i = 0;
+
+                for (; i + lanes <= count; i += lanes, mask >>= lanes)
+                {
+                    const std::uint64_t lane_mask = mask & lanes_mask;
+
+                    if constexpr (sizeof(T) == 4)
+                        _mm512_storeu_si512(out, _mm512_maskz_compress_epi32(static_cast<__mmask16>(lane_mask), Avx512::load(in + i)));
+                    else
+                        _mm512_storeu_si512(out, _mm512_maskz_compress_epi64(static_cast<__mmask8>(lane_mask), Avx512::load(in + i)));
+
+                    out += count_ones(lane_mask);
+                }
+
+                return (out - out_start) + Details::compress_scalar(in + i, count - i, mask, out);
+#elif defined(SIMD_KERNELS_HAS_AVX2)
+                constexpr std::size_t lanes = 32 / sizeof(T);
+                constexpr std::uint64_t lanes_mask = (std::uint64_t{1} << lanes) - 1;
+                static constexpr auto permutations = Details::make_compress_table<std::uint32_t, lanes, sizeof(T) / 4>();
+
+                T* const out_start = out;
+                std::size_t i = 0;
+
+                for (; i + lanes <= count; i += lanes, mask >>= lanes)
+                {
+                    const std::uint64_t lane_mask = mask & lanes_mask;
+                    const __m256i permutation = Avx2::load(permutations.indexes[lane_mask]);
+
+                    _mm256_storeu_si256(reinterpret_cast<__m256i*>(out), _mm256_permutevar8x32_epi32(Avx2::load(in + i), permutation));
+                    out += count_ones(lane_mask);
+                }
+
+                return (out - out_start) + Details::compress_scalar(in + i, count - i, mask, out);
+#elif defined(__SSSE3__) && defined(SIMD_KERNELS_HAS_SSE2)
+                constexpr std::size_t lanes = 16 / sizeof(T);
+                constexpr std::uint64_t lanes_mask = (std::uint64_t{1} << lanes) - 1;
+                static constexpr auto shuffles = Details::make_compress_table<std::uint8_t, lanes, sizeof(T)>();
+
+                T* const out_start = out;
+                std::size_t i = 0;
+
+                for (; i + lanes <= count; i += lanes, mask >>= lanes)
+                {
+                    const std::uint64_t lane_mask = mask & lanes_mask;
+                    const __m128i shuffle = Sse2::load(shuffles.indexes[lane_mask]);
+
+                    _mm_storeu_si128(reinterpret_cast<__m128i*>(out), _mm_shuffle_epi8(Sse2::load(in + i), shuffle));
+                    out += count_ones(lane_mask);
+                }
+
+                return (out - out_start) + Details::compress_scalar(in + i, count - i, mask, out);
+#endif
+            }
+
+            return Details::compress_scalar(in, count, mask, out);
+        }
+
+        template <Vectorizable T>
+        constexpr KernelSet<T> kernel_set{
+            &find<T>,
+            &sum_naive<T>,
+            &sum_pairwise<T>,
+            [] {
+                if constexpr (std::floating_point<T>)
+                    return &sum_kahan<T>;
+                else
+                    return &sum_naive<T>;
+            }(),
+            &min_of<T>,
+            &max_of<T>,
+            &minmax_of<T>,
+            &compress<T>};
+    } // namespace SIMD_KERNELS_VARIANT
+} // namespace SimdKernels
+
+#endif
@@ -0,0 +1,19 @@
+// SimdKernels built with -mavx512f -mavx512bw -mavx512vl -mavx512dq -mpopcnt - see CMakeLists.txt
+#include "simd_dispatch.hpp"
+
+#ifdef SIMD_DISPATCH_X86_VARIANTS
+
+namespace SimdDispatch::Variants
+{
+    template <Dispatched T>
+    const SimdKernels::KernelSet<T>& avx512()
+    {
+        return SimdKernels::avx512::kernel_set<T>;
+    }
+
+#define SIMD_DISPATCH_INSTANTIATE(T) template const SimdKernels::KernelSet<T>& avx512<T>();
+    SIMD_DISPATCH_FOR_EACH_TYPE(SIMD_DISPATCH_INSTANTIATE)
+#undef SIMD_DISPATCH_INSTANTIATE
+} // namespace SimdDispatch::Variants
+
+#endif
@@ -0,0 +1,20 @@
+// SimdKernels without intrinsics (SIMD_KERNELS_SCALAR) - registered for SimdLevel::Scalar
+#define SIMD_KERNELS_SCALAR
+#include "simd_dispatch.hpp"
+
+#ifdef SIMD_DISPATCH_X86_VARIANTS
+
+namespace SimdDispatch::Variants
+{
+    template <Dispatched T>
+    const SimdKernels::KernelSet<T>& scalar()
+    {
+        return SimdKernels::scalar::kernel_set<T>;
+    }
+
+#define SIMD_DISPATCH_INSTANTIATE(T) template const SimdKernels::KernelSet<T>& scalar<T>();
+    SIMD_DISPATCH_FOR_EACH_TYPE(SIMD_DISPATCH_INSTANTIATE)
+#undef SIMD_DISPATCH_INSTANTIATE
+} // namespace SimdDispatch::Variants
+
+#endif
@@ -0,0 +1,19 @@
+// SimdKernels built with -msse2 (x86-64 baseline) - see CMakeLists.txt
+#include "simd_dispatch.hpp"
+
+#ifdef SIMD_DISPATCH_X86_VARIANTS
+
+namespace SimdDispatch::Variants
+{
+    template <Dispatched T>
+    const SimdKernels::KernelSet<T>& sse2()
+    {
+        return SimdKernels::sse2::kernel_set<T>;
+    }
+
+#define SIMD_DISPATCH_INSTANTIATE(T) template const SimdKernels::KernelSet<T>& sse2<T>();
+    SIMD_DISPATCH_FOR_EACH_TYPE(SIMD_DISPATCH_INSTANTIATE)
+#undef SIMD_DISPATCH_INSTANTIATE
+} // namespace SimdDispatch::Variants
+
+#endif
@@ -0,0 +1,165 @@
+#ifndef SORTING_NETWORKS_HPP
+#define SORTING_NETWORKS_HPP
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+
+// Sorting networks generated at compile time
+//  - Batcher's merge-exchange (Knuth, TAOCP 5.2.2 M) - valid for any N, within a few comparators of the best known networks for N <= 32
+//  - a network is a fixed sequence of compare-exchanges - no data dependent branches, selects compile to cmov/blends
+namespace SortingNetworks
+{
+    inline constexpr std::size_t max_size = 32;
+
+    struct Comparator
+    {
+        std::uint8_t lower;
+        std::uint8_t upper;
+    };
+
+    namespace Details
+    {
+        // calls f(i, j) for every comparator of the network for n items
+        template <typename F>
+        constexpr void merge_exchange(std::size_t n, F f)
+        {
+            if (n < 2)
+                return;
+
+            std::size_t t = 0;
+            while ((std::size_t{1} << t) < n)
+                ++t;
+
+            for (std::size_t p = std::size_t{1} << (t - 1); p > 0; p /= 2)
+            {
+                std::size_t q = std::size_t{1} << (t - 1);
+                std::size_t r = 0;
+                std::size_t d = p;
+
+                while (true)
+                {
+                    for (std::size_t i = 0; i + d < n; ++i)
+                    {
+                        if ((i & p) == r)
+                            f(i, i + d);
+                    }
+
+                    if (q == p)
+                        break;
+
+                    d = q - p;
+                    q /= 2;
+                    r = p;
+                }
+            }
+        }
+
+        constexpr std::size_t comparator_count(std::size_t n)
+        {
+            std::size_t count = 0;
+            merge_exchange(n, [&](std::size_t, std::size_t) { ++count; });
+
+            return count;
+        }
+    } // namespace Details
+
+    template <std::size_t N>
+        requires(N <= max_size)
+    inline constexpr auto network = [] {
+        std::array<Comparator, Details::comparator_count(N)> comparators{};
+
+        std::size_t index = 0;
+        Details::merge_exchange(N, [&](std::size_t i, std::size_t j) {
+            comparators[index++] = {static_cast<std::uint8_t>(i), static_cast<std::uint8_t>(j)};
+        });
+
+        return comparators;
+    }();
+
+    namespace Details
+    {
+        // comparators of network<N> needed to place the nth item - a trailing comparator with both
+        // positions on one side of nth is dropped when no kept comparator reads its outputs later
+        template <std::size_t N, std::size_t Nth>
+        constexpr std::array<bool, network<N>.size()> selection_mask()
+        {
+            std::array<bool, network<N>.size()> kept{};
+            std::array<bool, N> touched{};
+
+            for (std::size_t index = network<N>.size(); index-- > 0;)
+            {
+                const auto [i, j] = network<N>[index];
+                const bool same_side = (j < Nth) || (i > Nth);
+
+                if (!same_side || touched[i] || touched[j])
+                {
+                    kept[index] = true;
+                    touched[i] = touched[j] = true;
+                }
+            }
+
+            return kept;
+        }
+    } // namespace Details
+
+    template <std::size_t N, std::size_t Nth>
+        requires(N <= max_size && Nth < N)
+    inline constexpr auto selection_network = [] {
+        constexpr auto kept = Details::selection_mask<N, Nth>();
+
+        std::array<Comparator, std::ranges::count(kept, true)> comparators{};
+
+        std::size_t index = 0;
+        for (std::size_t i = 0; i < network<N>.size(); ++i)
+        {
+            if (kept[i])
+                comparators[index++] = network<N>[i];
+        }
+
+        return comparators;
+    }();
+
+    // branchless for arithmetic types
+    template <typename T>
+    concept NetworkSortable = std::is_arithmetic_v<T>;
+
+    // one comparison selects both outputs - always a permutation of the inputs (-0.0 & NaN are kept, as by std::sort)
+    template <NetworkSortable T>
+    inline void compare_exchange(T& a, T& b)
+    {
+        const bool is_swapped = b < a;
+        const T lower = is_swapped ? b : a;
+        const T upper = is_swapped ? a : b;
+        a = lower;
+        b = upper;
+    }
+
+    template <const auto& Network, NetworkSortable T>
+    void apply(T* items)
+    {
+        [&]<std::size_t... Indexes>(std::index_sequence<Indexes...>) {
+            (compare_exchange(items[Network[Indexes].lower], items[Network[Indexes].upper]), ...);
+        }(std::make_index_sequence<Network.size()>{});
+    }
+
+    template <std::size_t N, NetworkSortable T>
+        requires(N <= max_size)
+    void sort(T* items)
+    {
+        apply<network<N>>(items);
+    }
+
+    // postcondition of std::nth_element
+    template <std::size_t N, std::size_t Nth, NetworkSortable T>
+        requires(N <= max_size && Nth < N)
+    void nth_element(T* items)
+    {
+        apply<selection_network<N, Nth>>(items);
+    }
+} // namespace SortingNetworks
+
+#endif
@@ -0,0 +1,457 @@
+#ifndef STRUCT_OF_ARRAYS_HPP
+#define STRUCT_OF_ARRAYS_HPP
+
+#include <compare>
+#include <concepts>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <span>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// Structure-of-arrays storage for aggregates
+//  - StructOfArrays<T, TAllocator> has the signature of std::vector, so it can be passed as
+//    a template template parameter (e.g. TemplateTemplateParam::Container<Order, SoA::StructOfArrays>)
+//  - every field listed in SoA::Fields<T> is kept in a separate array - a scan of one column touches only its bytes
+//  - items are accessed through proxy references (Reference is convertible to T & assignable from T)
+namespace SoA
+{
+    // reflection-lite - specialize for an aggregate with pointers to all of its fields:
+    //   template <>
+    //   struct SoA::Fields<Order>
+    //   {
+    //       static constexpr std::tuple members{&Order::id, &Order::price};
+    //   };
+    template <typename T>
+    struct Fields;
+
+    template <typename T>
+    concept Reflectable = std::is_aggregate_v<T> && requires { Fields<T>::members; };
+
+    namespace Details
+    {
+        template <typename TMember>
+        struct MemberTraits;
+
+        template <typename TField, typename TClass>
+        struct MemberTraits<TField TClass::*>
+        {
+            using field_type = TField;
+        };
+
+        template <auto Member>
+        using FieldType = typename MemberTraits<decltype(Member)>::field_type;
+
+        template <typename T>
+        inline constexpr std::size_t field_count = std::tuple_size_v<std::remove_const_t<decltype(Fields<T>::members)>>;
+
+        template <typename T, auto Member, std::size_t Index = 0>
+        constexpr std::size_t field_index()
+        {
+            static_assert(Index < field_count<T>, "Member is not listed in SoA::Fields<T>");
+
+            constexpr auto candidate = std::get<Index>(Fields<T>::members);
+
+            if constexpr (std::same_as<decltype(Member), std::remove_const_t<decltype(candidate)>>)
+            {
+                if constexpr (candidate == Member)
+                    return Index;
+                else
+                    return field_index<T, Member, Index + 1>();
+            }
+            else
+                return field_index<T, Member, Index + 1>();
+        }
+
+        template <typename T, typename TAllocator, typename TMembers>
+        struct Columns;
+
+        template <typename T, typename TAllocator, typename... TMembers>
+        struct Columns<T, TAllocator, std::tuple<TMembers...>>
+        {
+            using type = std::tuple<std::vector<typename MemberTraits<TMembers>::field_type,
+                typename std::allocator_traits<TAllocator>::template rebind_alloc<typename MemberTraits<TMembers>::field_type>>...>;
+        };
+    } // namespace Details
+
+    // unconstrained parameters - a constrained template does not match template <typename, typename> class
+    template <typename T, typename TAllocator = std::allocator<T>>
+    class StructOfArrays
+    {
+        static_assert(Reflectable<T>, "StructOfArrays requires an aggregate with SoA::Fields<T> specialization");
+
+        using Columns = typename Details::Columns<T, TAllocator, std::remove_const_t<decltype(Fields<T>::members)>>::type;
+
+        static constexpr std::size_t field_count = Details::field_count<T>;
+
+        Columns columns_;
+
+        template <std::size_t... Indexes>
+        static Columns make_columns(const TAllocator& allocator, std::index_sequence<Indexes...>)
+        {
+            return Columns{std::tuple_element_t<Indexes, Columns>(typename std::tuple_element_t<Indexes, Columns>::allocator_type(allocator))...};
+        }
+
+        template <typename TFunction>
+        static void for_each_field(TFunction&& f)
+        {
+            [&]<std::size_t... Indexes>(std::index_sequence<Indexes...>) {
+                (f(std::integral_constant<std::size_t, Indexes>{}), ...);
+            }(std::make_index_sequence<field_count>{});
+        }
+
+        template <bool IsConst>
+        class Iterator;
+
+        template <bool IsConst>
+        class Proxy
+        {
+            using Owner = std::conditional_t<IsConst, const StructOfArrays, StructOfArrays>;
+
+            Owner* owner_;
+            std::size_t index_;
+
+            friend class StructOfArrays;
+            friend class Iterator<IsConst>;
+
+            Proxy(Owner* owner, std::size_t index)
+                : owner_{owner}
+                , index_{index}
+            { }
+
+        public:
+            Proxy(const Proxy&) = default;
+
+            // assigns the referenced item - not the proxy
+            const Proxy& operator=(const T& item) const
+                requires(!IsConst)
+            {
+                owner_->assign(index_, item);
+                return *this;
+            }
+
+            const Proxy& operator=(const Proxy& other) const
+            {
+                return *this = static_cast<T>(other);
+            }
+
+            operator T() const
+            {
+                return owner_->load(index_);
+            }
+
+            // field of the referenced item: ref.get<&Order::price>()
+            template <auto Member>
+            auto& get() const
+            {
+                return std::get<Details::field_index<T, Member>()>(owner_->columns_)[index_];
+            }
+
+            friend bool operator==(const Proxy& lhs, const T& rhs)
+            {
+                return static_cast<T>(lhs) == rhs;
+            }
+
+            // swaps referenced items field by field - used by std::ranges algorithms (e.g. std::ranges::sort)
+            friend void swap(const Proxy& lhs, const Proxy& rhs)
+                requires(!IsConst)
+            {
+                lhs.swap_items(rhs);
+            }
+
+        private:
+            void swap_items(const Proxy& other) const
+            {
+                for_each_field([&](auto field) {
+                    std::ranges::swap(std::get<field>(owner_->columns_)[index_], std::get<field>(other.owner_->columns_)[other.index_]);
+                });
+            }
+        };
+
+        template <bool IsConst>
+        class Iterator
+        {
+            using Owner = std::conditional_t<IsConst, const StructOfArrays, StructOfArrays>;
+
+            Owner* owner_{};
+            std::ptrdiff_t index_{};
+
+        public:
+            using iterator_concept = std::random_access_iterator_tag;
+            using iterator_category = std::input_iterator_tag; // proxy references
+            using value_type = T;
+            using difference_type = std::ptrdiff_t;
+            using reference = Proxy<IsConst>;
+
+            Iterator() = default;
+
+            Iterator(Owner* owner, std::ptrdiff_t index)
+                : owner_{owner}
+                , index_{index}
+            { }
+
+            operator Iterator<true>() const
+                requires(!IsConst)
+            {
+                return Iterator<true>{owner_, index_};
+            }
+
+            reference operator*() const
+            {
+                return reference{owner_, static_cast<std::size_t>(index_)};
+            }
+
+            reference operator[](difference_type offset) const
+            {
+                return *(*this + offset);
+            }
+
+            Iterator& operator++()
+            {
+                ++index_;
+                return *this;
+            }
+
+            Iterator operator++(int)
+            {
+                Iterator it = *this;
+                ++index_;
+                return it;
+            }
+
+            Iterator& operator--()
+            {
+                --index_;
+                return *this;
+            }
+
+            Iterator operator--(int)
+            {
+                Iterator it = *this;
+                --index_;
+                return it;
+            }
+
+            Iterator& operator+=(difference_type offset)
+            {
+                index_ += offset;
+                return *this;
+            }
+
+            Iterator& operator-=(difference_type offset)
+            {
+                index_ -= offset;
+                return *this;
+            }
+
+            friend Iterator operator+(Iterator it, difference_type offset)
+            {
+                return it += offset;
+            }
+
+            friend Iterator operator+(difference_type offset, Iterator it)
+            {
+                return it += offset;
+            }
+
+            friend Iterator operator-(Iterator it, difference_type offset)
+            {
+                return it -= offset;
+            }
+
+            friend difference_type operator-(const Iterator& lhs, const Iterator& rhs)
+            {
+                return lhs.index_ - rhs.index_;
+            }
+
+            friend bool operator==(const Iterator& lhs, const Iterator& rhs)
+            {
+                return lhs.index_ == rhs.index_;
+            }
+
+            friend std::strong_ordering operator<=>(const Iterator& lhs, const Iterator& rhs)
+            {
+                return lhs.index_ <=> rhs.index_;
+            }
+        };
+
+        T load(std::size_t index) const
+        {
+            T item{};
+            for_each_field([&](auto field) {
+                item.*std::get<field>(Fields<T>::members) = std::get<field>(columns_)[index];
+            });
+
+            return item;
+        }
+
+        void assign(std::size_t index, const T& item)
+        {
+            for_each_field([&](auto field) {
+                std::get<field>(columns_)[index] = item.*std::get<field>(Fields<T>::members);
+            });
+        }
+
+    public:
+        using value_type = T;
+        using allocator_type = TAllocator;
+        using size_type = std::size_t;
+        using reference = Proxy<false>;
+        using const_reference = Proxy<true>;
+        using iterator = Iterator<false>;
+        using const_iterator = Iterator<true>;
+
+        StructOfArrays() = default;
+
+        // every column allocates with a copy of allocator rebound to its field type
+        explicit StructOfArrays(const TAllocator& allocator)
+            : columns_{make_columns(allocator, std::make_index_sequence<field_count>{})}
+        { }
+
+        explicit StructOfArrays(size_type size, const TAllocator& allocator = TAllocator{})
+            : StructOfArrays(allocator)
+        {
+            resize(size);
+        }
+
+        StructOfArrays(std::initializer_list<T> items, const TAllocator& allocator = TAllocator{})
+            : StructOfArrays(allocator)
+        {
+            reserve(items.size());
+            for (const T& item : items)
+                push_back(item);
+        }
+
+        allocator_type get_allocator() const
+        {
+            return TAllocator(std::get<0>(columns_).get_allocator());
+        }
+
+        size_type size() const
+        {
+            return std::get<0>(columns_).size();
+        }
+
+        bool empty() const
+        {
+            return size() == 0;
+        }
+
+        void reserve(size_type capacity)
+        {
+            for_each_field([&](auto field) { std::get<field>(columns_).reserve(capacity); });
+        }
+
+        void resize(size_type size)
+        {
+            for_each_field([&](auto field) { std::get<field>(columns_).resize(size); });
+        }
+
+        void clear()
+        {
+            for_each_field([&](auto field) { std::get<field>(columns_).clear(); });
+        }
+
+        // strong guarantee for columns - if a field constructor throws, fields already pushed are popped
+        void push_back(const T& item)
+        {
+            push_back_fields([&](auto field) -> const auto& { return item.*std::get<field>(Fields<T>::members); });
+        }
+
+        // on exception fields of item moved so far are left moved-from
+        void push_back(T&& item)
+        {
+            push_back_fields([&](auto field) -> auto&& { return std::move(item.*std::get<field>(Fields<T>::members)); });
+        }
+
+        template <typename... TArgs>
+        reference emplace_back(TArgs&&... args)
+        {
+            push_back(T(std::forward<TArgs>(args)...));
+            return back();
+        }
+
+        reference operator[](size_type index)
+        {
+            return reference{this, index};
+        }
+
+        const_reference operator[](size_type index) const
+        {
+            return const_reference{this, index};
+        }
+
+        reference back()
+        {
+            return (*this)[size() - 1];
+        }
+
+        // all values of one field: soa.column<&Order::price>()
+        template <auto Member>
+        std::span<Details::FieldType<Member>> column()
+        {
+            return std::get<Details::field_index<T, Member>()>(columns_);
+        }
+
+        template <auto Member>
+        std::span<const Details::FieldType<Member>> column() const
+        {
+            return std::get<Details::field_index<T, Member>()>(columns_);
+        }
+
+        iterator begin()
+        {
+            return iterator{this, 0};
+        }
+
+        iterator end()
+        {
+            return iterator{this, static_cast<std::ptrdiff_t>(size())};
+        }
+
+        const_iterator begin() const
+        {
+            return const_iterator{this, 0};
+        }
+
+        const_iterator end() const
+        {
+            return const_iterator{this, static_cast<std::ptrdiff_t>(size())};
+        }
+
+    private:
+        void reserve_for_push_back()
+        {
+            if (size() == std::get<0>(columns_).capacity())
+                reserve(size() == 0 ? 8 : 2 * size());
+        }
+
+        template <typename TGetField>
+        void push_back_fields(TGetField get_field)
+        {
+            reserve_for_push_back();
+
+            const size_type old_size = size();
+
+            try
+            {
+                for_each_field([&](auto field) { std::get<field>(columns_).push_back(get_field(field)); });
+            }
+            catch (...)
+            {
+                for_each_field([&](auto field) {
+                    if (auto& column = std::get<field>(columns_); column.size() > old_size)
+                        column.pop_back();
+                });
+
+                throw;
+            }
+        }
+    };
+} // namespace SoA
+
+#endif
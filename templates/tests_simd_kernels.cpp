@@ -0,0 +1,211 @@
+#include "noexcept_audit.hpp"
+#include "simd_dispatch.hpp"
+#include "simd_kernels.hpp"
+
+#include <catch2/catch_template_test_macros.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <limits>
+#include <numeric>
+#include <optional>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace
+{
+    // runs the check for every instruction set enabled by compiler flags
+    template <typename Check>
+    void for_each_isa(Check check)
+    {
+#ifdef SIMD_KERNELS_HAS_SSE2
+        check.template operator()<SimdKernels::Sse2>();
+#endif
+#ifdef SIMD_KERNELS_HAS_AVX2
+        check.template operator()<SimdKernels::Avx2>();
+#endif
+#ifdef SIMD_KERNELS_HAS_AVX512
+        check.template operator()<SimdKernels::Avx512>();
+#endif
+    }
+
+    // runs the check for every SIMD level supported by the CPU - restores the active level
+    template <typename Check>
+    void for_each_simd_level(Check check)
+    {
+        const Helpers::SimdLevel initial_level = Helpers::active_simd_level();
+
+        for (int level = 0; level <= static_cast<int>(Helpers::supported_simd_level()); ++level)
+        {
+            REQUIRE(Helpers::set_active_simd_level(static_cast<Helpers::SimdLevel>(level)));
+            check(static_cast<Helpers::SimdLevel>(level));
+        }
+
+        Helpers::set_active_simd_level(initial_level);
+    }
+} // namespace
+
+TEMPLATE_TEST_CASE("SimdKernels::find", "[simd]", std::int8_t, std::uint8_t, std::int16_t, std::uint16_t, std::int32_t, std::uint32_t, std::int64_t, std::uint64_t, float, double)
+{
+    using T = TestType;
+
+    // every position of a match (& no match) for lengths around register & unrolled block sizes
+    for (std::size_t size : {0, 1, 7, 15, 16, 17, 31, 32, 33, 63, 64, 65, 127, 128, 129, 255, 256, 257, 300})
+    {
+        std::vector<T> data(size, T{1});
+
+        for (std::size_t position = 0; position <= size; ++position)
+        {
+            if (position < size)
+                data[position] = T{2};
+
+            if (position + 1 < size)
+                data[size - 1] = T{2}; // a later match must not be reported
+
+            for_each_isa([&]<typename Isa>() {
+                const T* found = SimdKernels::find_with<Isa>(data.data(), data.data() + size, T{2});
+                REQUIRE(found == std::find(data.data(), data.data() + size, T{2}));
+            });
+
+            std::fill(data.begin(), data.end(), T{1});
+        }
+    }
+}
+
+TEST_CASE("SimdKernels::find - 64-bit values differing in one half", "[simd]")
+{
+    std::vector<std::uint64_t> data(40, 0x0000'0001'0000'0002);
+    data[33] = 0x0000'0002'0000'0002;
+
+    for_each_isa([&]<typename Isa>() {
+        REQUIRE(SimdKernels::find_with<Isa>(data.data(), data.data() + data.size(), std::uint64_t{0x0000'0002'0000'0002}) == &data[33]);
+        REQUIRE(SimdKernels::find_with<Isa>(data.data(), data.data() + data.size(), std::uint64_t{0x0000'0000'0000'0002}) == data.data() + data.size());
+    });
+}
+
+TEMPLATE_TEST_CASE("SimdKernels::find - floating point semantics", "[simd]", float, double)
+{
+    using T = TestType;
+
+    std::vector<T> data(100, T{1});
+    data[40] = std::numeric_limits<T>::quiet_NaN();
+    data[70] = T{-0.0};
+
+    for_each_isa([&]<typename Isa>() {
+        const T* end = data.data() + data.size();
+
+        REQUIRE(SimdKernels::find_with<Isa>(data.data(), end, std::numeric_limits<T>::quiet_NaN()) == end);
+        REQUIRE(SimdKernels::find_with<Isa>(data.data(), end, T{0.0}) == &data[70]);
+    });
+}
+
+TEST_CASE("DispatchTable - selects the best variant not above the active level", "[simd]")
+{
+    using Helpers::SimdLevel;
+
+    const Helpers::DispatchTable<int> table{{SimdLevel::Sse2, 2}, {SimdLevel::Avx2, 4}};
+
+    for_each_simd_level([&](SimdLevel level) {
+        if (level < SimdLevel::Avx2)
+        {
+            REQUIRE(table.active() == 2);
+            REQUIRE(table.active_variant() == SimdLevel::Sse2); // serves also the scalar level
+        }
+        else
+        {
+            REQUIRE(table.active() == 4);
+            REQUIRE(table.active_variant() == SimdLevel::Avx2);
+        }
+    });
+}
+
+TEST_CASE("DispatchTable - trivially copyable tables of function pointers", "[simd]")
+{
+    static_assert(Helpers::SpecialMembers<Helpers::CpuFeatures>::copy_constructor == Helpers::MemberGuarantee::trivial);
+    static_assert(Helpers::SpecialMembers<Helpers::DispatchTable<void (*)()>>::copy_constructor == Helpers::MemberGuarantee::trivial);
+    static_assert(Helpers::assert_nothrow_movable<Helpers::DispatchTable<void (*)()>>());
+}
+
+TEST_CASE("Active SIMD level", "[simd]")
+{
+    using Helpers::SimdLevel;
+
+    REQUIRE(Helpers::active_simd_level() <= Helpers::supported_simd_level());
+
+    SECTION("level forced by environment is capped to the CPU")
+    {
+        const char* forced = std::getenv(Helpers::simd_level_env_variable);
+        const auto forced_level = forced ? Helpers::parse_simd_level(forced) : std::nullopt;
+
+        if (forced_level)
+            REQUIRE(Helpers::active_simd_level() == std::min(*forced_level, Helpers::supported_simd_level()));
+        else
+            REQUIRE(Helpers::active_simd_level() == Helpers::supported_simd_level());
+    }
+
+    SECTION("level above the CPU cannot be set")
+    {
+        if (Helpers::supported_simd_level() < SimdLevel::Avx512)
+        {
+            const SimdLevel level = Helpers::active_simd_level();
+
+            REQUIRE_FALSE(Helpers::set_active_simd_level(SimdLevel::Avx512));
+            REQUIRE(Helpers::active_simd_level() == level);
+        }
+    }
+
+    SECTION("names")
+    {
+        for (int level = 0; level < static_cast<int>(Helpers::simd_level_count); ++level)
+            REQUIRE(Helpers::parse_simd_level(Helpers::to_string(static_cast<SimdLevel>(level))) == static_cast<SimdLevel>(level));
+
+        REQUIRE_FALSE(Helpers::parse_simd_level("avx1024").has_value());
+    }
+}
+
+TEMPLATE_TEST_CASE("SimdDispatch - every variant gives results of a serial loop", "[simd]", std::int8_t, std::uint16_t, std::int32_t, std::uint64_t, float, double)
+{
+    using T = TestType;
+
+    std::vector<T> data(1000);
+    for (std::size_t i = 0; i < data.size(); ++i)
+        data[i] = static_cast<T>((i * 37) % 101); // small integers - sums of floats are exact in any order
+    data[613] = T{120};
+
+    const T* first = data.data();
+    const T* last = data.data() + data.size();
+    const T expected_sum = std::accumulate(first, last, T{});
+
+    for_each_simd_level([&](Helpers::SimdLevel level) {
+        INFO("level: " << Helpers::to_string(level));
+
+        const Helpers::SimdLevel variant = SimdDispatch::dispatch_table<T>().active_variant();
+#ifdef SIMD_DISPATCH_X86_VARIANTS
+        REQUIRE(variant == level); // a variant for every level - scalar included
+#else
+        REQUIRE(variant <= level);
+#endif
+
+        REQUIRE(SimdDispatch::find(first, last, T{120}) == &data[613]);
+        REQUIRE(SimdDispatch::find(first, last, T{121}) == last);
+
+        REQUIRE(SimdDispatch::sum_naive(first, data.size()) == expected_sum);
+        REQUIRE(SimdDispatch::sum_pairwise(first, data.size()) == expected_sum);
+        if constexpr (std::floating_point<T>)
+            REQUIRE(SimdDispatch::sum_kahan(first, data.size()) == expected_sum);
+
+        REQUIRE(SimdDispatch::max_of(first, data.size()) == T{120});
+        REQUIRE(SimdDispatch::min_of(first, data.size()) == T{0});
+        REQUIRE(SimdDispatch::minmax_of(first, data.size()) == std::pair{T{0}, T{120}});
+
+        T selected[64 + SimdKernels::compress_padding<T>];
+        const std::uint64_t mask = 0xF0F0'0000'8000'0001;
+        REQUIRE(SimdDispatch::compress(first, 64, mask, selected) == 10);
+        REQUIRE(selected[0] == data[0]);
+        REQUIRE(selected[1] == data[31]);
+        REQUIRE(selected[9] == data[63]);
+    });
+}
@@ -0,0 +1,176 @@
+#include "struct_of_arrays.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+#include <algorithm>
+#include <iterator>
+#include <ranges>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <vector>
+
+namespace
+{
+    struct Trade
+    {
+        int id;
+        double price;
+        std::string symbol;
+
+        bool operator==(const Trade&) const = default;
+    };
+
+    // copy throws on the N-th call after arm(N)
+    struct Note
+    {
+        inline static int copies_until_throw = -1;
+
+        std::string text;
+
+        Note(std::string t)
+            : text{std::move(t)}
+        { }
+
+        Note(const Note& source)
+            : text{source.text}
+        {
+            if (copies_until_throw > 0 && --copies_until_throw == 0)
+                throw std::runtime_error("copy failed");
+        }
+
+        Note(Note&&) noexcept = default;
+        Note& operator=(const Note&) = default;
+        Note& operator=(Note&&) noexcept = default;
+
+        static void arm(int n)
+        {
+            copies_until_throw = n;
+        }
+    };
+
+    struct AnnotatedTrade
+    {
+        int id;
+        Note note; // columns before it are pushed when the copy throws, columns after it are not
+        double price;
+    };
+} // namespace
+
+template <>
+struct SoA::Fields<Trade>
+{
+    static constexpr std::tuple members{&Trade::id, &Trade::price, &Trade::symbol};
+};
+
+template <>
+struct SoA::Fields<AnnotatedTrade>
+{
+    static constexpr std::tuple members{&AnnotatedTrade::id, &AnnotatedTrade::note, &AnnotatedTrade::price};
+};
+
+using Trades = SoA::StructOfArrays<Trade>;
+
+static_assert(std::ranges::random_access_range<Trades>);
+static_assert(std::indirectly_writable<Trades::iterator, Trade>);
+static_assert(!std::indirectly_writable<Trades::const_iterator, Trade>);
+
+TEST_CASE("StructOfArrays - keeps each field in a separate array", "[soa]")
+{
+    Trades trades{{1, 10.5, "ABC"}, {2, 11.0, "XYZ"}};
+    trades.push_back(Trade{3, 9.75, "QQQ"});
+    trades.emplace_back(4, 12.25, "ABC");
+
+    REQUIRE(trades.size() == 4);
+
+    SECTION("columns")
+    {
+        REQUIRE(std::ranges::equal(trades.column<&Trade::id>(), std::vector{1, 2, 3, 4}));
+        REQUIRE(std::ranges::equal(trades.column<&Trade::price>(), std::vector{10.5, 11.0, 9.75, 12.25}));
+        REQUIRE(trades.column<&Trade::symbol>()[1] == "XYZ");
+    }
+
+    SECTION("proxy reference converts to an item")
+    {
+        const Trade trade = trades[2];
+
+        REQUIRE(trade == Trade{3, 9.75, "QQQ"});
+        REQUIRE(trades[3] == Trade{4, 12.25, "ABC"});
+    }
+
+    SECTION("assignment through proxy reference updates every column")
+    {
+        trades[1] = Trade{20, 1.5, "NEW"};
+        trades[0].get<&Trade::price>() = 99.0;
+
+        REQUIRE(trades[1] == Trade{20, 1.5, "NEW"});
+        REQUIRE(trades.column<&Trade::price>()[0] == 99.0);
+
+        trades[2] = trades[3]; // copies an item - does not rebind the proxy
+        REQUIRE(trades[2] == Trade{4, 12.25, "ABC"});
+        REQUIRE(trades[3] == Trade{4, 12.25, "ABC"});
+    }
+
+    SECTION("const access")
+    {
+        const Trades& const_trades = trades;
+
+        REQUIRE(const_trades[0].get<&Trade::symbol>() == "ABC");
+
+        std::vector<Trade> copy(const_trades.begin(), const_trades.end());
+        REQUIRE(copy.back() == Trade{4, 12.25, "ABC"});
+    }
+}
+
+TEST_CASE("StructOfArrays - works with std::ranges algorithms", "[soa]")
+{
+    Trades trades{{3, 30.0, "C"}, {1, 10.0, "A"}, {2, 20.0, "B"}};
+
+    std::ranges::sort(trades, std::ranges::less{}, [](const Trade& trade) { return trade.id; });
+
+    REQUIRE(std::ranges::equal(trades.column<&Trade::id>(), std::vector{1, 2, 3}));
+    REQUIRE(std::ranges::equal(trades.column<&Trade::symbol>(), std::vector<std::string>{"A", "B", "C"}));
+
+    auto pos = std::ranges::find_if(trades, [](const Trade& trade) { return trade.price > 15.0; });
+    REQUIRE(pos - trades.begin() == 1);
+}
+
+TEST_CASE("StructOfArrays - size & capacity", "[soa]")
+{
+    Trades trades(3);
+
+    REQUIRE(trades.size() == 3);
+    REQUIRE(trades[2] == Trade{});
+
+    trades.clear();
+    REQUIRE(trades.empty());
+
+    for (int i = 0; i < 1000; ++i)
+        trades.push_back(Trade{i, i * 0.5, std::to_string(i)});
+
+    REQUIRE(trades.size() == 1000);
+    REQUIRE(trades[999] == Trade{999, 499.5, "999"});
+}
+
+TEST_CASE("StructOfArrays - push_back rolls back columns when a field copy throws", "[soa]")
+{
+    SoA::StructOfArrays<AnnotatedTrade> trades;
+    const AnnotatedTrade trade{1, Note{"note"}, 10.0};
+
+    Note::arm(4); // the 4th push_back throws
+    trades.push_back(trade);
+    trades.push_back(trade);
+    trades.push_back(trade);
+
+    REQUIRE_THROWS_AS(trades.push_back(trade), std::runtime_error);
+
+    REQUIRE(trades.size() == 3);
+    REQUIRE(trades.column<&AnnotatedTrade::id>().size() == 3);
+    REQUIRE(trades.column<&AnnotatedTrade::note>().size() == 3);
+    REQUIRE(trades.column<&AnnotatedTrade::price>().size() == 3);
+
+    Note::arm(-1);
+    trades.push_back(AnnotatedTrade{2, Note{"next"}, 20.0});
+
+    REQUIRE(std::ranges::equal(trades.column<&AnnotatedTrade::id>(), std::vector{1, 1, 1, 2}));
+    REQUIRE(trades.column<&AnnotatedTrade::note>()[3].text == "next");
+}
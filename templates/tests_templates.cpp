@@ -1,12 +1,40 @@
+#include "array_expressions.hpp"
 #include "helpers.hpp"
-
+#include "noexcept_audit.hpp"
+#include "relocating_vector.hpp"
+#include "simd_dispatch.hpp"
+#include "simd_kernels.hpp"
+#include "sorting_networks.hpp"
+#include "struct_of_arrays.hpp"
+
+#include <algorithm>
 #include <array>
+#include <atomic>
+#include <cassert>
+#include <catch2/benchmark/catch_benchmark.hpp>
 #include <catch2/catch_template_test_macros.hpp>
 #include <catch2/catch_test_macros.hpp>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <execution>
 #include <iostream>
+#include <iterator>
+#include <limits>
 #include <list>
 #include <memory>
+#include <memory_resource>
+#include <new>
+#include <numeric>
+#include <random>
+#include <ranges>
+#include <stdexcept>
 #include <string>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
 using Helpers::Gadget;
@@ -48,6 +76,120 @@ const char* maximum(const char* a, const char* b)
     return std::strcmp(a, b) < 0 ? b : a;
 }
 
+template <typename T>
+T minimum(T a, T b)
+{
+    return (b < a) ? b : a;
+}
+
+const char* minimum(const char* a, const char* b)
+{
+    return std::strcmp(b, a) < 0 ? b : a;
+}
+
+///////////////////////////////////////////////////////////////////
+// range reductions - folds of maximum/minimum over non-empty ranges
+//  - contiguous arithmetic data - branchless SIMD kernels
+//  - random access ranges - four independent folds (unrollable, no single dependency chain)
+//  - other ranges - a plain fold; overloads of maximum/minimum (e.g. strcmp for const char*) apply
+
+namespace RangeReductions
+{
+    template <typename TRange>
+    concept VectorizableRange = std::ranges::contiguous_range<TRange> && SimdKernels::Vectorizable<std::ranges::range_value_t<TRange>>;
+
+    template <typename TRange, typename Fold>
+    auto fold(TRange&& rng, Fold fold_op) -> std::ranges::range_value_t<TRange>
+    {
+        using T = std::ranges::range_value_t<TRange>;
+
+        auto it = std::ranges::begin(rng);
+        const auto last = std::ranges::end(rng);
+        assert(it != last);
+
+        T result = *it;
+
+        if constexpr (std::ranges::random_access_range<TRange>)
+        {
+            T partials[3] = {result, result, result};
+
+            for (; last - it >= 4; it += 4)
+            {
+                result = fold_op(result, T(it[0]));
+                partials[0] = fold_op(partials[0], T(it[1]));
+                partials[1] = fold_op(partials[1], T(it[2]));
+                partials[2] = fold_op(partials[2], T(it[3]));
+            }
+
+            for (const T& partial : partials)
+                result = fold_op(result, partial);
+        }
+
+        for (; it != last; ++it)
+            result = fold_op(result, T(*it));
+
+        return result;
+    }
+} // namespace RangeReductions
+
+template <std::ranges::input_range TRange>
+auto range_maximum(TRange&& rng) -> std::ranges::range_value_t<TRange>
+{
+    if constexpr (RangeReductions::VectorizableRange<TRange>)
+    {
+        assert(!std::ranges::empty(rng));
+        return SimdDispatch::max_of(std::ranges::data(rng), std::ranges::size(rng));
+    }
+    else
+    {
+        return RangeReductions::fold(rng, [](const auto& a, const auto& b) { return maximum(a, b); });
+    }
+}
+
+template <std::ranges::input_range TRange>
+auto range_minimum(TRange&& rng) -> std::ranges::range_value_t<TRange>
+{
+    if constexpr (RangeReductions::VectorizableRange<TRange>)
+    {
+        assert(!std::ranges::empty(rng));
+        return SimdDispatch::min_of(std::ranges::data(rng), std::ranges::size(rng));
+    }
+    else
+    {
+        return RangeReductions::fold(rng, [](const auto& a, const auto& b) { return minimum(a, b); });
+    }
+}
+
+// (minimum, maximum) in one pass
+template <std::ranges::input_range TRange>
+auto range_minmax(TRange&& rng) -> std::pair<std::ranges::range_value_t<TRange>, std::ranges::range_value_t<TRange>>
+{
+    using T = std::ranges::range_value_t<TRange>;
+
+    if constexpr (RangeReductions::VectorizableRange<TRange>)
+    {
+        assert(!std::ranges::empty(rng));
+        return SimdDispatch::minmax_of(std::ranges::data(rng), std::ranges::size(rng));
+    }
+    else
+    {
+        auto it = std::ranges::begin(rng);
+        const auto last = std::ranges::end(rng);
+        assert(it != last);
+
+        std::pair<T, T> result{*it, *it};
+
+        for (++it; it != last; ++it)
+        {
+            const T item = *it;
+            result.first = minimum(result.first, item);
+            result.second = maximum(result.second, item);
+        }
+
+        return result;
+    }
+}
+
 template <typename T>
 void compilation_phases(T a)
 {
@@ -102,6 +244,110 @@ TEST_CASE("function templates")
     }
 }
 
+TEST_CASE("range reductions")
+{
+    SECTION("contiguous arithmetic data")
+    {
+        std::vector<int> vec = {4, -7, 42, 0, 665, 13, -100, 8, 9};
+
+        CHECK(range_maximum(vec) == 665);
+        CHECK(range_minimum(vec) == -100);
+        CHECK(range_minmax(vec) == std::pair{-100, 665});
+    }
+
+    SECTION("non-contiguous data")
+    {
+        std::list<double> lst = {3.14, -1.0, 2.72, 42.0, 0.0};
+
+        CHECK(range_maximum(lst) == 42.0);
+        CHECK(range_minimum(lst) == -1.0);
+        CHECK(range_minmax(lst) == std::pair{-1.0, 42.0});
+    }
+
+    SECTION("const char* - compared with strcmp")
+    {
+        std::string texts[] = {"Ola", "Ala", "Zenon", "Ewa"};
+        std::vector<const char*> words;
+        for (const auto& text : texts)
+            words.push_back(text.c_str()); // pointer order differs from text order in general
+
+        CHECK(range_maximum(words) == "Zenon"s);
+        CHECK(range_minimum(words) == "Ala"s);
+        CHECK(range_minmax(words).first == "Ala"s);
+    }
+
+    SECTION("strings")
+    {
+        const std::array<std::string, 5> words = {"def", "abc", "xyz", "klm", "aaa"};
+
+        CHECK(range_maximum(words) == "xyz");
+        CHECK(range_minimum(words) == "aaa");
+    }
+
+    SECTION("leading NaN propagates as in a fold of maximum")
+    {
+        std::vector<double> vec(100, 1.0);
+        vec[50] = std::numeric_limits<double>::quiet_NaN();
+
+        CHECK(range_maximum(vec) == 1.0);
+
+        vec[0] = std::numeric_limits<double>::quiet_NaN();
+        CHECK(std::isnan(range_maximum(vec)));
+    }
+}
+
+TEMPLATE_TEST_CASE("range reductions - same results as std::minmax_element", "[algorithm]", int, std::int8_t, std::uint16_t, float, double)
+{
+    std::mt19937_64 rnd{665};
+    std::uniform_int_distribution<int> distribution{-100, 100};
+
+    for (std::size_t size : {1, 2, 3, 31, 64, 65, 1'000, 4'097})
+    {
+        std::vector<TestType> vec(size);
+        std::generate(vec.begin(), vec.end(), [&] { return static_cast<TestType>(distribution(rnd)); });
+
+        const auto [min_it, max_it] = std::minmax_element(vec.begin(), vec.end());
+
+        CHECK(range_maximum(vec) == *max_it);
+        CHECK(range_minimum(vec) == *min_it);
+        CHECK(range_minmax(vec) == std::pair{*min_it, *max_it});
+
+        const std::deque<TestType> dq(vec.begin(), vec.end()); // random access, not contiguous
+        CHECK(range_maximum(dq) == *max_it);
+        CHECK(range_minimum(dq) == *min_it);
+    }
+}
+
+TEMPLATE_TEST_CASE("range reductions vs. std::max_element/std::minmax_element", "[.benchmark]", int, float, double)
+{
+    std::vector<TestType> vec(1'000'000);
+    std::mt19937_64 rnd{665};
+    std::uniform_int_distribution<int> distribution{-1'000'000, 1'000'000};
+    std::generate(vec.begin(), vec.end(), [&] { return static_cast<TestType>(distribution(rnd)); });
+
+    BENCHMARK("std::max_element")
+    {
+        return *std::max_element(vec.begin(), vec.end());
+    };
+
+    BENCHMARK("range_maximum")
+    {
+        return range_maximum(vec);
+    };
+
+    BENCHMARK("std::minmax_element")
+    {
+        const auto [min_it, max_it] = std::minmax_element(vec.begin(), vec.end());
+        return *min_it + *max_it;
+    };
+
+    BENCHMARK("range_minmax")
+    {
+        const auto [min, max] = range_minmax(vec);
+        return min + max;
+    };
+}
+
 namespace Exercise
 {
     template <typename InputIterator, typename TValue>
@@ -118,6 +364,22 @@ namespace Exercise
         return stop;
     }
 
+    // contiguous arithmetic data compared in a domain of the element type - SIMD kernel
+    template <typename InputIterator, typename TValue>
+        requires std::contiguous_iterator<InputIterator>
+        && SimdKernels::Vectorizable<std::iter_value_t<InputIterator>>
+        && std::is_arithmetic_v<TValue>
+        && std::same_as<std::common_type_t<std::iter_value_t<InputIterator>, TValue>, std::iter_value_t<InputIterator>>
+    InputIterator find(InputIterator start, InputIterator stop, TValue value)
+    {
+        using T = std::iter_value_t<InputIterator>;
+
+        const T* first = std::to_address(start);
+        const T* pos = SimdDispatch::find(first, first + (stop - start), static_cast<T>(value));
+
+        return start + (pos - first);
+    }
+
     template <typename InputIterator, typename OutputIterator>
     void copy(InputIterator from_start, InputIterator from_stop, OutputIterator to_start)
     {
@@ -146,6 +408,60 @@ TEMPLATE_TEST_CASE("find", "[algorithm]", (std::array<int, 10>), (std::vector<in
     }
 }
 
+TEMPLATE_TEST_CASE("find - long ranges", "[algorithm]", (std::vector<int>), (std::vector<double>), (std::vector<char>), (std::vector<long long>), (std::list<int>))
+{
+    using T = typename TestType::value_type;
+
+    TestType data(1'000);
+    std::iota(data.begin(), data.end(), T{});
+
+    for (int value : {0, 63, 64, 100, 998, 999, 1'000})
+    {
+        auto expected = std::find_if(data.begin(), data.end(), [=](const T& item) { return item == static_cast<T>(value); });
+        CHECK(Exercise::find(data.begin(), data.end(), static_cast<T>(value)) == expected);
+    }
+}
+
+namespace Benchmark
+{
+    template <typename TContainer>
+    void find_positions(const TContainer& data)
+    {
+        using T = typename TContainer::value_type;
+
+        const std::size_t size = std::size(data);
+        const std::pair<const char*, std::size_t> positions[] = {{"start", 0}, {"middle", size / 2}, {"end", size - 1}, {"absent", size}};
+
+        for (const auto& [name, position] : positions)
+        {
+            TContainer haystack = data;
+            if (position < size)
+                *std::next(haystack.begin(), position) = T{2};
+
+            BENCHMARK("Exercise::find - match at " + std::string(name))
+            {
+                return Exercise::find(haystack.begin(), haystack.end(), T{2});
+            };
+
+            BENCHMARK("std::find - match at " + std::string(name))
+            {
+                return std::find(haystack.begin(), haystack.end(), T{2});
+            };
+        }
+    }
+} // namespace Benchmark
+
+TEMPLATE_TEST_CASE("find - SIMD vs. generic", "[.benchmark]", (std::array<int, 10>), (std::vector<int>), (std::vector<double>), (std::list<int>))
+{
+    TestType data{};
+    if constexpr (requires { data.resize(1); })
+        data.resize(1'000'000);
+
+    std::fill(data.begin(), data.end(), typename TestType::value_type{1});
+
+    Benchmark::find_positions(data);
+}
+
 TEMPLATE_TEST_CASE("copy", "[algorithm]", (std::array<int, 10>), (std::vector<int>), (std::vector<double>), (std::list<int>))
 {
     TestType tab1 = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10};
@@ -187,6 +503,193 @@ namespace Exercise
 
         return stop;
     }
+
+    namespace Details
+    {
+        // index of the first item satisfying predicate - chunks are taken in order by a pool of threads
+        //  - best holds the lowest index found so far; a chunk starting past it is skipped
+        //    and a running scan stops once it passes it - the result does not depend on scheduling
+        template <typename RandomIterator, typename Predicate>
+        std::ptrdiff_t parallel_find_index(RandomIterator start, std::ptrdiff_t size, Predicate& predicate, unsigned thread_count)
+        {
+            constexpr std::ptrdiff_t cancellation_check_step = 256;
+
+            const std::ptrdiff_t chunk_size = std::max<std::ptrdiff_t>(4 * cancellation_check_step, size / (8 * thread_count));
+
+            std::atomic<std::ptrdiff_t> next_chunk{0};
+            std::atomic<std::ptrdiff_t> best{size};
+
+            auto scan_chunk = [&](std::ptrdiff_t chunk_start, std::ptrdiff_t chunk_stop) {
+                for (std::ptrdiff_t block = chunk_start; block < chunk_stop; block += cancellation_check_step)
+                {
+                    if (best.load(std::memory_order_relaxed) < block)
+                        return;
+
+                    const std::ptrdiff_t block_stop = std::min(chunk_stop, block + cancellation_check_step);
+
+                    for (std::ptrdiff_t i = block; i < block_stop; ++i)
+                    {
+                        if (predicate(start[i]))
+                        {
+                            std::ptrdiff_t current = best.load(std::memory_order_relaxed);
+                            while (i < current && !best.compare_exchange_weak(current, i, std::memory_order_relaxed))
+                            { }
+
+                            return; // later items of the chunk cannot improve the result
+                        }
+                    }
+                }
+            };
+
+            auto worker = [&] {
+                for (;;)
+                {
+                    const std::ptrdiff_t chunk_start = next_chunk.fetch_add(chunk_size, std::memory_order_relaxed);
+
+                    if (chunk_start >= std::min(size, best.load(std::memory_order_relaxed)))
+                        return;
+
+                    scan_chunk(chunk_start, std::min(size, chunk_start + chunk_size));
+                }
+            };
+
+            {
+                std::vector<std::jthread> threads;
+                threads.reserve(thread_count - 1);
+
+                for (unsigned i = 1; i < thread_count; ++i)
+                    threads.emplace_back(worker);
+
+                worker();
+            } // join
+
+            return best.load(std::memory_order_relaxed);
+        }
+    } // namespace Details
+
+    template <typename ExecutionPolicy, typename InputIterator, typename Predicate>
+        requires std::is_execution_policy_v<std::remove_cvref_t<ExecutionPolicy>>
+    InputIterator find_if(ExecutionPolicy&&, InputIterator start, InputIterator stop, Predicate predicate)
+    {
+        constexpr std::ptrdiff_t min_parallel_size = 16 * 1024;
+
+        if constexpr (std::is_same_v<std::remove_cvref_t<ExecutionPolicy>, std::execution::sequenced_policy>
+            || !std::random_access_iterator<InputIterator>)
+        {
+            return Exercise::find_if(start, stop, predicate);
+        }
+        else
+        {
+            const std::ptrdiff_t size = stop - start;
+            const unsigned thread_count = std::max(1u, std::thread::hardware_concurrency());
+
+            if (size < min_parallel_size || thread_count == 1)
+                return Exercise::find_if(start, stop, predicate);
+
+            return start + Details::parallel_find_index(start, size, predicate, thread_count);
+        }
+    }
+
+    namespace Details
+    {
+        inline constexpr std::size_t compaction_block_size = 64;
+
+        // predicate is evaluated for a whole block first - a loop without branches (vectorized for simple predicates)
+        // then selected items are compacted by SIMD shuffles/compress (or a branchless scalar loop)
+        template <typename T, typename Predicate, typename BlockConsumer>
+        void for_each_block_mask(const T* data, std::size_t size, Predicate& predicate, BlockConsumer consume)
+        {
+            std::uint8_t flags[compaction_block_size] = {};
+
+            for (std::size_t i = 0; i < size; i += compaction_block_size)
+            {
+                const std::size_t count = std::min(compaction_block_size, size - i);
+
+                for (std::size_t j = 0; j < count; ++j)
+                    flags[j] = static_cast<bool>(predicate(data[i + j]));
+
+                std::fill(flags + count, std::end(flags), 0);
+
+                consume(data + i, count, SimdKernels::mask_of_flags(flags));
+            }
+        }
+
+        template <typename InputIterator>
+        concept CompactableRange = std::contiguous_iterator<InputIterator> && SimdKernels::Vectorizable<std::iter_value_t<InputIterator>>;
+    } // namespace Details
+
+    template <typename InputIterator, typename OutputIterator, typename Predicate>
+    OutputIterator copy_if(InputIterator start, InputIterator stop, OutputIterator dest, Predicate predicate)
+    {
+        if constexpr (Details::CompactableRange<InputIterator>)
+        {
+            using T = std::iter_value_t<InputIterator>;
+
+            T selected[Details::compaction_block_size + SimdKernels::compress_padding<T>];
+            const auto compress = SimdDispatch::kernels<T>().compress;
+
+            Details::for_each_block_mask(std::to_address(start), static_cast<std::size_t>(stop - start), predicate,
+                [&](const T* block, std::size_t count, std::uint64_t mask) {
+                    const std::size_t selected_count = compress(block, count, mask, selected);
+                    dest = std::copy_n(selected, selected_count, dest);
+                });
+
+            return dest;
+        }
+        else
+        {
+            for (InputIterator it{start}; it != stop; ++it)
+            {
+                if (predicate(*it))
+                {
+                    *dest = *it;
+                    ++dest;
+                }
+            }
+
+            return dest;
+        }
+    }
+
+    template <typename InputIterator, typename OutputIterator1, typename OutputIterator2, typename Predicate>
+    std::pair<OutputIterator1, OutputIterator2> partition_copy(InputIterator start, InputIterator stop,
+        OutputIterator1 dest_true, OutputIterator2 dest_false, Predicate predicate)
+    {
+        if constexpr (Details::CompactableRange<InputIterator>)
+        {
+            using T = std::iter_value_t<InputIterator>;
+
+            T selected[Details::compaction_block_size + SimdKernels::compress_padding<T>];
+            const auto compress = SimdDispatch::kernels<T>().compress;
+
+            Details::for_each_block_mask(std::to_address(start), static_cast<std::size_t>(stop - start), predicate,
+                [&](const T* block, std::size_t count, std::uint64_t mask) {
+                    std::size_t selected_count = compress(block, count, mask, selected);
+                    dest_true = std::copy_n(selected, selected_count, dest_true);
+
+                    selected_count = compress(block, count, ~mask, selected);
+                    dest_false = std::copy_n(selected, selected_count, dest_false);
+                });
+        }
+        else
+        {
+            for (InputIterator it{start}; it != stop; ++it)
+            {
+                if (predicate(*it))
+                {
+                    *dest_true = *it;
+                    ++dest_true;
+                }
+                else
+                {
+                    *dest_false = *it;
+                    ++dest_false;
+                }
+            }
+        }
+
+        return {dest_true, dest_false};
+    }
 } // namespace Exercise
 
 TEMPLATE_TEST_CASE("find_if", "[algorithm]", (std::vector<int>))
@@ -215,85 +718,265 @@ TEMPLATE_TEST_CASE("find_if", "[algorithm]", (std::vector<int>))
     }
 }
 
-template <typename T, typename TContainer = std::vector<T>>
-class Container
+TEMPLATE_TEST_CASE("find_if - with execution policy", "[algorithm,parallel]", (std::vector<int>))
 {
-    TContainer items;
-
-public:
-    using iterator = typename TContainer::iterator;
-    using const_iterator = typename TContainer::const_iterator;
-
-    Container(size_t size = 0)
-        : items(size)
-    { }
-
-    Container(std::initializer_list<T> lst)
-        : items(lst.size())
+    SECTION("item found")
     {
-        std::copy(lst.begin(), lst.end(), items.begin());
+        TestType vec = {665, 667, 42, 77};
+        auto pos = Exercise::find_if(std::execution::par, vec.begin(), vec.end(), is_even);
+        CHECK(pos != vec.end());
+        CHECK(*pos == 42);
     }
 
-    template <typename U>
-    void push_back(U&& item)
+    SECTION("item not found")
     {
-        items.push_back(std::forward<U>(item)); // copy
+        TestType vec = {665, 667, 77};
+        auto pos = Exercise::find_if(std::execution::par, vec.begin(), vec.end(), IsEven{});
+        CHECK(pos == vec.end());
     }
 
-    template <typename... TArgs>
-    void emplace_back(TArgs&&... args)
+    SECTION("with lambda")
     {
-        items.emplace_back(std::forward<TArgs>(args)...);
+        TestType vec = {665, 667, 42, 77};
+        auto pos = Exercise::find_if(std::execution::seq, vec.begin(), vec.end(), [](int n) { return n % 2 == 0; });
+        CHECK(pos != vec.end());
+        CHECK(*pos == 42);
     }
 
-    void push_back_by_value(T item)
+    SECTION("large range - first of many matches")
     {
-        std::cout << "void push_back(const std::string& item: " << item << ")\n";
-        items.push_back(std::move(item)); // copy
-    }
+        TestType vec(1'000'000, 1);
 
-    iterator begin()
-    {
-        return items.begin();
-    }
+        for (std::size_t position : {0, 4'095, 250'000, 999'999})
+        {
+            vec[position] = 42;
+            vec[std::min<std::size_t>(position + 100'000, vec.size() - 1)] = 42;
 
-    iterator end()
-    {
-        return items.end();
-    }
+            auto pos = Exercise::find_if(std::execution::par, vec.begin(), vec.end(), is_even);
+            CHECK(pos == Exercise::find_if(vec.begin(), vec.end(), is_even));
 
-    const_iterator begin() const
-    {
-        return items.begin();
-    }
+            for (unsigned thread_count : {2, 3, 16}) // regardless of hardware_concurrency
+            {
+                const auto index = Exercise::Details::parallel_find_index(vec.begin(), std::ssize(vec), is_even, thread_count);
+                CHECK(index == static_cast<std::ptrdiff_t>(position));
+            }
 
-    const_iterator end() const
-    {
-        return items.end();
+            std::fill(vec.begin(), vec.end(), 1);
+        }
+
+        CHECK(Exercise::find_if(std::execution::par_unseq, vec.begin(), vec.end(), IsEven{}) == vec.end());
     }
-};
+}
 
-namespace TemplateTemplateParam
+TEST_CASE("find_if - sequential vs. parallel", "[.benchmark]")
 {
-    template <typename T, template <typename, typename> class TContainer = std::vector>
-    class Container
+    std::vector<int> vec(200'000'000, 1);
+    vec[vec.size() * 3 / 4] = 42;
+
+    BENCHMARK("Exercise::find_if")
+    {
+        return Exercise::find_if(vec.begin(), vec.end(), is_even);
+    };
+
+    BENCHMARK("Exercise::find_if(std::execution::par)")
+    {
+        return Exercise::find_if(std::execution::par, vec.begin(), vec.end(), is_even);
+    };
+}
+
+TEMPLATE_TEST_CASE("copy_if & partition_copy", "[algorithm]", int, std::int8_t, std::uint16_t, float, double, long long)
+{
+    using T = TestType;
+
+    auto is_small = [](T item) { return item < T{50}; };
+
+    for (std::size_t size : {0, 1, 5, 63, 64, 65, 128, 1'000})
+    {
+        std::vector<T> data(size);
+        for (std::size_t i = 0; i < size; ++i)
+            data[i] = static_cast<T>((i * 37) % 100);
+
+        std::vector<T> expected;
+        std::copy_if(data.begin(), data.end(), std::back_inserter(expected), is_small);
+
+        SECTION("copy_if - size " + std::to_string(size))
+        {
+            std::vector<T> result(size);
+            auto result_end = Exercise::copy_if(data.begin(), data.end(), result.begin(), is_small);
+
+            CHECK(std::equal(result.begin(), result_end, expected.begin(), expected.end()));
+        }
+
+        SECTION("copy_if to list - size " + std::to_string(size))
+        {
+            std::list<T> result;
+            Exercise::copy_if(data.begin(), data.end(), std::back_inserter(result), is_small);
+
+            CHECK(std::equal(result.begin(), result.end(), expected.begin(), expected.end()));
+        }
+
+        SECTION("partition_copy - size " + std::to_string(size))
+        {
+            std::vector<T> expected_false;
+            std::remove_copy_if(data.begin(), data.end(), std::back_inserter(expected_false), is_small);
+
+            std::vector<T> result_true(size);
+            std::vector<T> result_false(size);
+
+            auto [true_end, false_end] = Exercise::partition_copy(data.begin(), data.end(), result_true.begin(), result_false.begin(), is_small);
+
+            CHECK(std::equal(result_true.begin(), true_end, expected.begin(), expected.end()));
+            CHECK(std::equal(result_false.begin(), false_end, expected_false.begin(), expected_false.end()));
+        }
+    }
+}
+
+TEST_CASE("copy_if - predicates from find_if", "[algorithm]")
+{
+    const std::vector<int> vec = {665, 667, 42, 77, 8, 0, -2};
+    const std::list<int> lst(vec.begin(), vec.end());
+    const std::vector<int> expected = {42, 8, 0, -2};
+
+    std::vector<int> result;
+
+    Exercise::copy_if(vec.begin(), vec.end(), std::back_inserter(result), is_even);
+    CHECK(result == expected);
+
+    result.clear();
+    Exercise::copy_if(vec.begin(), vec.end(), std::back_inserter(result), IsEven{});
+    CHECK(result == expected);
+
+    result.clear();
+    Exercise::copy_if(lst.begin(), lst.end(), std::back_inserter(result), [](int n) { return n % 2 == 0; });
+    CHECK(result == expected);
+
+    const std::vector<std::string> words = {"one", "three", "four"};
+    std::vector<std::string> long_words;
+    Exercise::copy_if(words.begin(), words.end(), std::back_inserter(long_words), [](const std::string& w) { return w.size() > 3; });
+    CHECK(long_words == std::vector<std::string>{"three", "four"});
+}
+
+TEST_CASE("copy_if - 50% selectivity", "[.benchmark]")
+{
+    std::vector<int> data(100'000'000); // input & two outputs - 1e9 items would need 12 GB
+
+    std::mt19937 rnd{42};
+    std::generate(data.begin(), data.end(), [&] { return static_cast<int>(rnd()); });
+
+    std::vector<int> output(data.size());
+    std::vector<int> rejected(data.size());
+
+    BENCHMARK("std::copy_if")
+    {
+        return std::copy_if(data.begin(), data.end(), output.begin(), IsEven{});
+    };
+
+    BENCHMARK("Exercise::copy_if")
+    {
+        return Exercise::copy_if(data.begin(), data.end(), output.begin(), IsEven{});
+    };
+
+    BENCHMARK("std::partition_copy")
+    {
+        return std::partition_copy(data.begin(), data.end(), output.begin(), rejected.begin(), IsEven{});
+    };
+
+    BENCHMARK("Exercise::partition_copy")
+    {
+        return Exercise::partition_copy(data.begin(), data.end(), output.begin(), rejected.begin(), IsEven{});
+    };
+}
+
+template <typename T, typename TContainer = std::vector<T>>
+class Container
+{
+    TContainer items;
+
+public:
+    using iterator = typename TContainer::iterator;
+    using const_iterator = typename TContainer::const_iterator;
+
+    Container(size_t size = 0)
+        : items(size)
+    { }
+
+    Container(std::initializer_list<T> lst)
+        : items(lst.size())
+    {
+        std::copy(lst.begin(), lst.end(), items.begin());
+    }
+
+    template <typename U>
+    void push_back(U&& item)
+    {
+        items.push_back(std::forward<U>(item)); // copy
+    }
+
+    template <typename... TArgs>
+    void emplace_back(TArgs&&... args)
+    {
+        items.emplace_back(std::forward<TArgs>(args)...);
+    }
+
+    void push_back_by_value(T item)
+    {
+        std::cout << "void push_back(const std::string& item: " << item << ")\n";
+        items.push_back(std::move(item)); // copy
+    }
+
+    iterator begin()
     {
-        TContainer<T, std::allocator<T>> items;
+        return items.begin();
+    }
+
+    iterator end()
+    {
+        return items.end();
+    }
+
+    const_iterator begin() const
+    {
+        return items.begin();
+    }
+
+    const_iterator end() const
+    {
+        return items.end();
+    }
+};
+
+namespace TemplateTemplateParam
+{
+    template <typename T, template <typename, typename> class TContainer = std::vector, typename TAllocator = std::allocator<T>>
+    class Container
+    {
+        TContainer<T, TAllocator> items;
 
     public:
-        using iterator = typename TContainer<T, std::allocator<T>>::iterator;
-        using const_iterator = typename TContainer<T, std::allocator<T>>::const_iterator;
+        using allocator_type = TAllocator;
+        using iterator = typename TContainer<T, TAllocator>::iterator;
+        using const_iterator = typename TContainer<T, TAllocator>::const_iterator;
 
-        Container(size_t size = 0)
-            : items(size)
+        Container(size_t size = 0, const TAllocator& allocator = TAllocator{})
+            : items(size, allocator)
         { }
 
-        Container(std::initializer_list<T> lst)
-            : items(lst.size())
+        Container(std::initializer_list<T> lst, const TAllocator& allocator = TAllocator{})
+            : items(lst.size(), allocator)
         {
             std::copy(lst.begin(), lst.end(), items.begin());
         }
 
+        allocator_type get_allocator() const
+        {
+            return items.get_allocator();
+        }
+
+        iterator erase(const_iterator position)
+        {
+            return items.erase(position);
+        }
+
         template <typename U>
         void push_back(U&& item)
         {
@@ -331,17 +1014,57 @@ namespace TemplateTemplateParam
         {
             return items.end();
         }
+
+        // values of one field - for storages keeping fields in separate arrays (e.g. SoA::StructOfArrays)
+        template <auto Member>
+        auto column() const
+            requires requires(const TContainer<T, TAllocator>& storage) { storage.template column<Member>(); }
+        {
+            return items.template column<Member>();
+        }
     };
+
+    namespace pmr
+    {
+        // items allocated from a std::pmr::memory_resource (e.g. a per-request arena)
+        template <typename T, template <typename, typename> class TContainer = std::vector>
+        using Container = TemplateTemplateParam::Container<T, TContainer, std::pmr::polymorphic_allocator<T>>;
+    } // namespace pmr
 } // namespace TemplateTemplateParam
 
 template <typename T, size_t N>
 struct Array
 {
-    T items[N];
+    alignas(ArrayExpressions::storage_alignment<T, N>) T items[N];
 
+    using value_type = T;
     using iterator = T*;
     using const_iterator = const T*;
 
+    static constexpr size_t extent = N;
+
+    // a = b * 2 + c - d - evaluated in one loop, without temporary arrays
+    template <ArrayExpressions::Operand TExpression>
+        requires(TExpression::extent == N)
+    Array& operator=(const TExpression& expression)
+    {
+        return ArrayExpressions::assign(*this, expression);
+    }
+
+    template <ArrayExpressions::Operand TExpression>
+        requires(TExpression::extent == N)
+    Array& operator+=(const TExpression& expression)
+    {
+        return ArrayExpressions::assign(*this, ArrayExpressions::operator+(*this, expression));
+    }
+
+    template <ArrayExpressions::Operand TExpression>
+        requires(TExpression::extent == N)
+    Array& operator-=(const TExpression& expression)
+    {
+        return ArrayExpressions::assign(*this, ArrayExpressions::operator-(*this, expression));
+    }
+
     size_t size() const
     {
         return N;
@@ -378,6 +1101,14 @@ struct Array
     }
 };
 
+// element-wise arithmetic for Array (found by ADL - Array is a member of the global namespace)
+using ArrayExpressions::operator+;
+using ArrayExpressions::operator-;
+using ArrayExpressions::operator*;
+using ArrayExpressions::operator/;
+using ArrayExpressions::dot;
+using ArrayExpressions::norm;
+
 TEST_CASE("class templates")
 {
     TemplateTemplateParam::Container<std::string, std::list> container;
@@ -403,6 +1134,649 @@ TEST_CASE("class templates")
     }
 }
 
+TEST_CASE("Array - expression templates", "[array]")
+{
+    Array<double, 4> a{};
+    Array<double, 4> b = {1.0, 2.0, 3.0, 4.0};
+    Array<double, 4> c = {10.0, 20.0, 30.0, 40.0};
+    Array<double, 4> d = {0.5, 0.5, 0.5, 0.5};
+
+    static_assert(std::is_aggregate_v<Array<double, 4>>);
+    static_assert(alignof(Array<float, 4>) == 16);
+    static_assert(alignof(Array<double, 8>) == 64);
+    static_assert(std::same_as<decltype(b + c), ArrayExpressions::Binary<Array<double, 4>, Array<double, 4>, std::plus<>>>); // no temporary array
+
+    SECTION("fused element-wise expression")
+    {
+        a = b * 2 + c - d;
+        REQUIRE(std::ranges::equal(a, std::vector{11.5, 23.5, 35.5, 47.5}));
+    }
+
+    SECTION("scalar operands & negation")
+    {
+        a = 1.0 / (2.0 * b) + -d;
+        REQUIRE(std::ranges::equal(a, std::vector{0.0, -0.25, 1.0 / 6.0 - 0.5, -0.375}));
+    }
+
+    SECTION("scalar of other type - items of common type")
+    {
+        const Array<int, 4> i = {1, 2, 3, 4};
+        static_assert(std::same_as<decltype(i * 2.5)::value_type, double>);
+
+        a = i * 2.5;
+        REQUIRE(std::ranges::equal(a, std::vector{2.5, 5.0, 7.5, 10.0}));
+
+        a = 1.0 / (i + 0.5);
+        REQUIRE(std::ranges::equal(a, std::vector{1.0 / 1.5, 1.0 / 2.5, 1.0 / 3.5, 1.0 / 4.5}));
+    }
+
+    SECTION("destination used in expression")
+    {
+        b = b * b + b;
+        REQUIRE(std::ranges::equal(b, std::vector{2.0, 6.0, 12.0, 20.0}));
+
+        c -= b;
+        c += d;
+        REQUIRE(std::ranges::equal(c, std::vector{8.5, 14.5, 18.5, 20.5}));
+    }
+
+    SECTION("dot & norm")
+    {
+        REQUIRE(dot(b, c) == 300.0);
+        REQUIRE(dot(b + b, d) == 10.0);
+
+        Array<double, 3> v = {3.0, 4.0, 12.0};
+        REQUIRE(norm(v) == 13.0);
+    }
+
+    SECTION("arrays longer than unroll limit")
+    {
+        Array<int, 100> x{};
+        Array<int, 100> y{};
+        std::iota(x.begin(), x.end(), 0);
+        std::fill(y.begin(), y.end(), 1);
+
+        Array<int, 100> z{};
+        z = x * 3 - y;
+        REQUIRE(z[0] == -1);
+        REQUIRE(z[99] == 296);
+        REQUIRE(dot(x, y) == 4950);
+    }
+}
+
+namespace Benchmark
+{
+    // one loop & one temporary array per operation
+    template <typename T, size_t N, typename TOperation>
+    Array<T, N> apply(const Array<T, N>& lhs, const Array<T, N>& rhs, TOperation operation)
+    {
+        Array<T, N> result;
+        for (size_t i = 0; i < N; ++i)
+            result[i] = operation(lhs[i], rhs[i]);
+
+        return result;
+    }
+
+    template <typename T, size_t N>
+    Array<T, N> scale(const Array<T, N>& array, T factor)
+    {
+        Array<T, N> result;
+        for (size_t i = 0; i < N; ++i)
+            result[i] = array[i] * factor;
+
+        return result;
+    }
+
+    template <typename T, size_t N>
+    std::vector<Array<T, N>> random_arrays(size_t count)
+    {
+        std::mt19937 rnd{665};
+        std::uniform_real_distribution<T> distribution(-1.0, 1.0);
+
+        std::vector<Array<T, N>> arrays(count);
+        for (auto& array : arrays)
+            std::ranges::generate(array, [&] { return distribution(rnd); });
+
+        return arrays;
+    }
+} // namespace Benchmark
+
+TEMPLATE_TEST_CASE_SIG("Array - expression templates vs. temporaries", "[.benchmark]", ((size_t N), N), 3, 4, 8, 16)
+{
+    constexpr size_t count = 1'000'000;
+
+    const auto b = Benchmark::random_arrays<float, N>(count);
+    const auto c = Benchmark::random_arrays<float, N>(count);
+    const auto d = Benchmark::random_arrays<float, N>(count);
+    std::vector<Array<float, N>> a(count);
+
+    BENCHMARK("temporaries: a = b * 2 + c - d - N: " + std::to_string(N))
+    {
+        for (size_t i = 0; i < count; ++i)
+            a[i] = Benchmark::apply(Benchmark::apply(Benchmark::scale(b[i], 2.0f), c[i], std::plus<>{}), d[i], std::minus<>{});
+
+        return a[count - 1][0];
+    };
+
+    BENCHMARK("expression templates: a = b * 2 + c - d - N: " + std::to_string(N))
+    {
+        for (size_t i = 0; i < count; ++i)
+            a[i] = b[i] * 2 + c[i] - d[i];
+
+        return a[count - 1][0];
+    };
+
+    BENCHMARK("expression templates: dot(b, c) - N: " + std::to_string(N))
+    {
+        float sum = 0.0f;
+        for (size_t i = 0; i < count; ++i)
+            sum += dot(b[i], c[i]);
+
+        return sum;
+    };
+}
+
+namespace StoragePolicies
+{
+    struct Order
+    {
+        int id;
+        double price;
+        int quantity;
+        long long timestamp;
+    };
+
+    double total_price(const auto& orders)
+    {
+        double total = 0.0;
+        for (const Order& order : orders)
+            total += order.price;
+
+        return total;
+    }
+} // namespace StoragePolicies
+
+template <>
+struct SoA::Fields<StoragePolicies::Order>
+{
+    using Order = StoragePolicies::Order;
+
+    static constexpr std::tuple members{&Order::id, &Order::price, &Order::quantity, &Order::timestamp};
+};
+
+TEST_CASE("class templates - storage policy", "[soa]")
+{
+    using StoragePolicies::Order;
+
+    TemplateTemplateParam::Container<Order, SoA::StructOfArrays> orders = {{1, 10.0, 5, 100}, {2, 20.5, 1, 101}};
+    orders.emplace_back(3, 30.0, 2, 102);
+    orders.push_back(Order{4, 0.5, 8, 103});
+
+    REQUIRE(StoragePolicies::total_price(orders) == 61.0);
+
+    auto prices = orders.column<&Order::price>();
+    REQUIRE(std::accumulate(prices.begin(), prices.end(), 0.0) == 61.0);
+    REQUIRE(orders.column<&Order::quantity>()[3] == 8);
+}
+
+TEST_CASE("class templates - allocator-aware Container", "[pmr]")
+{
+    using StoragePolicies::Order;
+
+    std::byte buffer[4096];
+    std::pmr::monotonic_buffer_resource arena{buffer, sizeof(buffer), std::pmr::null_memory_resource()};
+
+    SECTION("std::vector")
+    {
+        TemplateTemplateParam::pmr::Container<int> container({1, 2, 3}, &arena);
+        container.push_back(4);
+
+        REQUIRE(container.get_allocator().resource() == &arena);
+        REQUIRE(std::ranges::equal(container, std::vector{1, 2, 3, 4}));
+    }
+
+    SECTION("std::list")
+    {
+        TemplateTemplateParam::pmr::Container<std::string, std::list> container(0, &arena);
+        container.emplace_back(3, '*');
+
+        REQUIRE(*container.begin() == "***");
+    }
+
+    SECTION("SoA::StructOfArrays - every column uses the resource")
+    {
+        TemplateTemplateParam::pmr::Container<Order, SoA::StructOfArrays> orders(0, &arena);
+        orders.push_back(Order{1, 10.0, 5, 100});
+
+        REQUIRE(orders.get_allocator().resource() == &arena);
+        REQUIRE(orders.column<&Order::price>()[0] == 10.0);
+    }
+}
+
+namespace Relocation
+{
+    // trivially relocatable in practice - but not marked as such
+    struct Resource
+    {
+        std::unique_ptr<int> ptr;
+    };
+} // namespace Relocation
+
+TEST_CASE("class templates - relocating storage", "[relocation]")
+{
+    static_assert(Helpers::IsTriviallyRelocatable_v<std::unique_ptr<int>>);
+    static_assert(!Helpers::IsTriviallyRelocatable_v<Relocation::Resource>);
+
+    TemplateTemplateParam::Container<std::unique_ptr<int>, Helpers::RelocatingVector> pointers;
+    for (int i = 0; i < 100; ++i)
+        pointers.push_back(std::make_unique<int>(i)); // grows by memcpy
+
+    pointers.erase(pointers.begin() + 10); // memmove of the tail
+    REQUIRE(**(pointers.begin() + 10) == 11);
+    REQUIRE(std::distance(pointers.begin(), pointers.end()) == 99);
+
+    TemplateTemplateParam::Container<Relocation::Resource, Helpers::RelocatingVector> resources;
+    for (int i = 0; i < 100; ++i)
+        resources.emplace_back(std::make_unique<int>(i)); // grows by move constructor
+
+    resources.erase(resources.begin());
+    REQUIRE(*resources.begin()->ptr == 1);
+
+    TemplateTemplateParam::Container<std::string, Helpers::RelocatingVector> words = {"one", "two", "three"};
+    words.push_back(std::string(100, 'x'));
+    words.erase(words.begin() + 1);
+    REQUIRE(std::ranges::equal(words, std::vector<std::string>{"one", "three", std::string(100, 'x')}));
+}
+
+TEST_CASE("class templates - relocating storage with polymorphic allocators", "[relocation]")
+{
+    using Words = TemplateTemplateParam::pmr::Container<std::string, Helpers::RelocatingVector>;
+
+    std::pmr::monotonic_buffer_resource source_resource;
+    std::pmr::monotonic_buffer_resource target_resource;
+
+    Words source({"one", "two", std::string(100, 'x')}, &source_resource);
+    Words target({"zero"}, &target_resource);
+
+    SECTION("copy assignment - allocator is not propagated")
+    {
+        target = source;
+
+        REQUIRE(std::ranges::equal(target, source));
+        REQUIRE(target.get_allocator().resource() == &target_resource);
+    }
+
+    SECTION("move assignment - items are moved one by one to the other resource")
+    {
+        target = std::move(source);
+
+        REQUIRE(std::ranges::equal(target, std::vector<std::string>{"one", "two", std::string(100, 'x')}));
+        REQUIRE(target.get_allocator().resource() == &target_resource);
+    }
+
+    SECTION("move assignment - equal allocators - storage is taken over")
+    {
+        Words other({"zero"}, &source_resource);
+        const std::string* first = &*source.begin();
+
+        other = std::move(source);
+
+        REQUIRE(&*other.begin() == first);
+    }
+
+    SECTION("swap - equal allocators")
+    {
+        Helpers::RelocatingVector<std::string, std::pmr::polymorphic_allocator<std::string>> a({"a"}, &source_resource);
+        Helpers::RelocatingVector<std::string, std::pmr::polymorphic_allocator<std::string>> b({"b", "c"}, &source_resource);
+
+        a.swap(b);
+
+        REQUIRE(a.size() == 2);
+        REQUIRE(*b.begin() == "a");
+    }
+}
+
+namespace Relocation
+{
+    struct ThrowingCopy
+    {
+        inline static int copies_left = 0;
+        inline static int live_count = 0;
+
+        std::string value;
+
+        ThrowingCopy(std::string v)
+            : value{std::move(v)}
+        {
+            ++live_count;
+        }
+
+        ThrowingCopy(const ThrowingCopy& source)
+            : value{source.value}
+        {
+            if (copies_left-- == 0)
+                throw std::runtime_error("copy failed");
+
+            ++live_count;
+        }
+
+        ThrowingCopy(ThrowingCopy&& source) noexcept
+            : value{std::move(source.value)}
+        {
+            ++live_count;
+        }
+
+        ~ThrowingCopy()
+        {
+            --live_count;
+        }
+    };
+} // namespace Relocation
+
+TEST_CASE("class templates - relocating storage - throwing item constructor", "[relocation]")
+{
+    using Relocation::ThrowingCopy;
+    using Vector = Helpers::RelocatingVector<ThrowingCopy, Helpers::AuditingAllocator<ThrowingCopy>>;
+
+    // items built so far are destroyed & the buffer is released (the audit tracks the live block in debug builds)
+    Helpers::ReallocationAudit audit;
+    const Helpers::AuditingAllocator<ThrowingCopy> allocator{audit};
+
+    ThrowingCopy::copies_left = 2;
+    REQUIRE_THROWS_AS((Vector{{ThrowingCopy{std::string(100, 'a')}, ThrowingCopy{"b"}, ThrowingCopy{"c"}}, allocator}), std::runtime_error);
+
+    REQUIRE(ThrowingCopy::live_count == 0);
+    REQUIRE(audit.live_block == nullptr);
+
+    {
+        ThrowingCopy::copies_left = -1;
+        const Vector source({ThrowingCopy{std::string(100, 'a')}, ThrowingCopy{"b"}}, allocator);
+
+        ThrowingCopy::copies_left = 1;
+        REQUIRE_THROWS_AS(Vector{source}, std::runtime_error);
+
+        REQUIRE(ThrowingCopy::live_count == 2); // items of source only
+    }
+
+    REQUIRE(ThrowingCopy::live_count == 0);
+    REQUIRE(audit.live_block == nullptr);
+}
+
+TEMPLATE_TEST_CASE("growth with & without relocation", "[.benchmark]", std::unique_ptr<int>, Relocation::Resource)
+{
+    using T = TestType;
+
+    for (int size : {0, 1'000, 100'000, 10'000'000})
+    {
+        const std::string suffix = " - size: " + std::to_string(size);
+
+        BENCHMARK("std::vector" + suffix)
+        {
+            TemplateTemplateParam::Container<T, std::vector> container;
+            for (int i = 0; i < size; ++i)
+                container.emplace_back();
+
+            return container;
+        };
+
+        BENCHMARK("Helpers::RelocatingVector" + suffix)
+        {
+            TemplateTemplateParam::Container<T, Helpers::RelocatingVector> container;
+            for (int i = 0; i < size; ++i)
+                container.emplace_back();
+
+            return container;
+        };
+    }
+
+    BENCHMARK_ADVANCED("erase from front - 100'000 items - std::vector")(Catch::Benchmark::Chronometer meter)
+    {
+        TemplateTemplateParam::Container<T, std::vector> container(100'000);
+        meter.measure([&] { return container.begin() != container.end() ? container.erase(container.begin()) : container.end(); });
+    };
+
+    BENCHMARK_ADVANCED("erase from front - 100'000 items - Helpers::RelocatingVector")(Catch::Benchmark::Chronometer meter)
+    {
+        TemplateTemplateParam::Container<T, Helpers::RelocatingVector> container(100'000);
+        meter.measure([&] { return container.begin() != container.end() ? container.erase(container.begin()) : container.end(); });
+    };
+}
+
+TEST_CASE("storage policy - AoS vs. SoA vs. list", "[.benchmark]")
+{
+    using StoragePolicies::Order;
+
+    constexpr int size = 10'000'000;
+
+    TemplateTemplateParam::Container<Order, std::vector> aos;
+    TemplateTemplateParam::Container<Order, SoA::StructOfArrays> soa;
+    TemplateTemplateParam::Container<Order, std::list> list;
+
+    std::mt19937_64 rnd{42};
+    std::uniform_real_distribution<double> price_distribution(1.0, 100.0);
+    for (int i = 0; i < size; ++i)
+    {
+        const Order order{i, price_distribution(rnd), i % 100, 1'700'000'000LL + i};
+        aos.push_back(order);
+        soa.push_back(order);
+        list.push_back(order);
+    }
+
+    BENCHMARK("AoS (std::vector) - scan of price")
+    {
+        return StoragePolicies::total_price(aos);
+    };
+
+    BENCHMARK("SoA - scan of price column")
+    {
+        double total = 0.0;
+        for (double price : soa.column<&Order::price>())
+            total += price;
+
+        return total;
+    };
+
+    BENCHMARK("SoA - scan of items (proxy references)")
+    {
+        return StoragePolicies::total_price(soa);
+    };
+
+    BENCHMARK("std::list - scan of price")
+    {
+        return StoragePolicies::total_price(list);
+    };
+}
+
+// sorting networks for small arrays of numbers - introsort (std::sort) otherwise
+template <typename T, size_t N>
+void sort(Array<T, N>& array)
+{
+    if constexpr (N <= SortingNetworks::max_size && SortingNetworks::NetworkSortable<T>)
+        SortingNetworks::sort<N>(array.items);
+    else
+        std::sort(array.begin(), array.end());
+}
+
+// network pruned to the comparators that place the Nth item
+template <size_t Nth, typename T, size_t N>
+    requires(Nth < N)
+void nth_element(Array<T, N>& array)
+{
+    if constexpr (N <= SortingNetworks::max_size && SortingNetworks::NetworkSortable<T>)
+        SortingNetworks::nth_element<N, Nth>(array.items);
+    else
+        std::nth_element(array.begin(), array.begin() + Nth, array.end());
+}
+
+// nth known at runtime - a sorted array satisfies nth_element
+template <typename T, size_t N>
+void nth_element(Array<T, N>& array, size_t nth)
+{
+    assert(nth < N);
+
+    if constexpr (N <= SortingNetworks::max_size && SortingNetworks::NetworkSortable<T>)
+        SortingNetworks::sort<N>(array.items);
+    else
+        std::nth_element(array.begin(), array.begin() + nth, array.end());
+}
+
+namespace Benchmark
+{
+    enum class Order {
+        Random,
+        Sorted,
+        Reversed
+    };
+
+    template <typename T, size_t N>
+    std::vector<Array<T, N>> arrays_to_sort(size_t count, Order order)
+    {
+        std::mt19937 rnd{42};
+        std::uniform_int_distribution<int> distribution(-1000, 1000);
+
+        std::vector<Array<T, N>> arrays(count);
+        for (auto& array : arrays)
+        {
+            std::ranges::generate(array, [&] { return static_cast<T>(distribution(rnd)); });
+
+            if (order == Order::Sorted)
+                std::ranges::sort(array);
+            else if (order == Order::Reversed)
+                std::ranges::sort(array, std::greater<>{});
+        }
+
+        return arrays;
+    }
+} // namespace Benchmark
+
+TEMPLATE_TEST_CASE_SIG("sort(Array<T, N>) - sorting networks", "[array]", ((size_t N), N), 1, 2, 3, 4, 5, 7, 8, 9, 13, 16, 17, 24, 31, 32, 33, 100)
+{
+    SECTION("every 0-1 input is sorted (0-1 principle)")
+    {
+        if constexpr (N <= 16)
+        {
+            for (uint32_t bits = 0; bits < (uint32_t{1} << N); ++bits)
+            {
+                Array<int, N> array;
+                for (size_t i = 0; i < N; ++i)
+                    array[i] = (bits >> i) & 1;
+
+                sort(array);
+                REQUIRE(std::ranges::is_sorted(array));
+            }
+        }
+    }
+
+    SECTION("output is a permutation of input - signed zeros & NaN")
+    {
+        Array<double, N> zeros;
+        for (size_t i = 0; i < N; ++i)
+            zeros[i] = (i % 2 == 0) ? 0.0 : -0.0;
+
+        sort(zeros);
+        REQUIRE(std::ranges::count_if(zeros, [](double x) { return std::signbit(x); }) == N / 2);
+
+        if constexpr (N <= SortingNetworks::max_size) // NaN breaks the strict weak ordering required by std::sort
+        {
+            Array<double, N> with_nan;
+            for (size_t i = 0; i < N; ++i)
+                with_nan[i] = static_cast<double>(N - i);
+            with_nan[N / 2] = std::numeric_limits<double>::quiet_NaN();
+
+            sort(with_nan);
+            REQUIRE(std::ranges::count_if(with_nan, [](double x) { return std::isnan(x); }) == 1);
+        }
+    }
+
+    SECTION("random inputs")
+    {
+        auto arrays = Benchmark::arrays_to_sort<double, N>(1000, Benchmark::Order::Random);
+
+        for (auto& array : arrays)
+        {
+            Array<double, N> expected = array;
+            std::ranges::sort(expected);
+
+            sort(array);
+            REQUIRE(std::ranges::equal(array, expected));
+        }
+    }
+
+    SECTION("nth_element")
+    {
+        auto arrays = Benchmark::arrays_to_sort<int, N>(1000, Benchmark::Order::Random);
+
+        for (auto& array : arrays)
+        {
+            constexpr size_t median = N / 2;
+
+            Array<int, N> expected = array;
+            std::ranges::sort(expected);
+
+            Array<int, N> runtime_nth = array;
+            nth_element(runtime_nth, median);
+            nth_element<median>(array);
+
+            REQUIRE(array[median] == expected[median]);
+            REQUIRE(runtime_nth[median] == expected[median]);
+            REQUIRE(std::all_of(array.begin(), array.begin() + median, [&](int x) { return x <= array[median]; }));
+            REQUIRE(std::all_of(array.begin() + median, array.end(), [&](int x) { return x >= array[median]; }));
+        }
+    }
+}
+
+TEST_CASE("sorting networks - pruned selection networks", "[array]")
+{
+    static_assert(SortingNetworks::network<4>.size() == 5);
+    static_assert(SortingNetworks::network<16>.size() == 63);
+    static_assert(SortingNetworks::selection_network<16, 8>.size() < SortingNetworks::network<16>.size());
+    static_assert(SortingNetworks::selection_network<32, 0>.size() < SortingNetworks::network<32>.size());
+
+    Array<std::string, 3> words = {"c", "a", "b"};
+    sort(words); // std::sort - not a number
+    REQUIRE(std::ranges::equal(words, std::vector<std::string>{"a", "b", "c"}));
+}
+
+TEMPLATE_TEST_CASE_SIG("sort(Array<T, N>) vs. std::sort", "[.benchmark]", ((size_t N), N), 4, 8, 16, 32, 64)
+{
+    constexpr size_t count = 10'000;
+
+    // every run sorts its own copy of input
+    auto benchmark = [](auto& meter, const auto& arrays, auto sort_one) {
+        std::vector runs(meter.runs(), arrays);
+        meter.measure([&](int run) {
+            for (auto& array : runs[run])
+                sort_one(array);
+        });
+    };
+
+    for (auto [order, order_name] : {std::pair{Benchmark::Order::Random, "random"}, {Benchmark::Order::Sorted, "sorted"}, {Benchmark::Order::Reversed, "reversed"}})
+    {
+        const auto arrays = Benchmark::arrays_to_sort<float, N>(count, order);
+        const std::string suffix = " - N: " + std::to_string(N) + ", " + order_name;
+
+        BENCHMARK_ADVANCED("std::sort" + suffix)(Catch::Benchmark::Chronometer meter)
+        {
+            benchmark(meter, arrays, [](auto& array) { std::sort(array.begin(), array.end()); });
+        };
+
+        BENCHMARK_ADVANCED("sort(Array)" + suffix)(Catch::Benchmark::Chronometer meter)
+        {
+            benchmark(meter, arrays, [](auto& array) { sort(array); });
+        };
+
+        BENCHMARK_ADVANCED("std::nth_element - median" + suffix)(Catch::Benchmark::Chronometer meter)
+        {
+            benchmark(meter, arrays, [](auto& array) { std::nth_element(array.begin(), array.begin() + N / 2, array.end()); });
+        };
+
+        BENCHMARK_ADVANCED("nth_element<N / 2>(Array)" + suffix)(Catch::Benchmark::Chronometer meter)
+        {
+            benchmark(meter, arrays, [](auto& array) { nth_element<N / 2>(array); });
+        };
+    }
+}
+
 constexpr double my_pi_d = 3.141592653589793238462643383279502884197;
 constexpr float my_pi_f = 3.141592653589793238462643383279502884197;
 
@@ -544,21 +1918,144 @@ namespace Ver_1
 
 inline namespace Ver_2
 {
-    template <typename T>
-    auto sum(const T& vec) -> std::decay_t<decltype(*std::begin(vec))> // const int
+    namespace Accuracy
     {
-        using ValueType = std::decay_t<decltype(*std::begin(vec))>;
+        struct Naive // error of floats grows linearly with the size of a range
+        { };
 
-        ValueType sum{};  // const int sum{};
+        struct Pairwise // error grows with log of the size
+        { };
 
-        for (const auto& e : vec)
+        struct Kahan // compensated - error does not depend on the size
+        { };
+    } // namespace Accuracy
+
+    namespace Reduction
+    {
+        inline constexpr std::size_t parallel_min_size = 1 << 20;
+
+        template <typename TValue, typename Iterator, typename TAccuracy>
+        TValue generic_sum(Iterator first, Iterator last, TAccuracy)
         {
-            sum += e;
+            TValue sum{};
+
+            if constexpr (std::is_same_v<TAccuracy, Accuracy::Kahan> && std::is_floating_point_v<TValue>)
+            {
+                TValue compensation{};
+
+                for (auto it = first; it != last; ++it)
+                {
+                    const TValue y = *it - compensation;
+                    const TValue t = sum + y;
+                    compensation = (t - sum) - y;
+                    sum = t;
+                }
+            }
+            else if constexpr (std::is_same_v<TAccuracy, Accuracy::Pairwise> && std::is_floating_point_v<TValue>)
+            {
+                // binary counter of partial sums - partials[level] covers 2^level blocks
+                constexpr std::size_t block_size = 128;
+
+                TValue partials[64] = {};
+                std::uint64_t occupied = 0;
+
+                for (auto it = first; it != last;)
+                {
+                    TValue block{};
+                    for (std::size_t i = 0; i < block_size && it != last; ++i, ++it)
+                        block += *it;
+
+                    std::size_t level = 0;
+                    for (; occupied & (std::uint64_t{1} << level); ++level)
+                    {
+                        block = partials[level] + block;
+                        occupied &= ~(std::uint64_t{1} << level);
+                    }
+
+                    partials[level] = block;
+                    occupied |= std::uint64_t{1} << level;
+                }
+
+                for (std::size_t level = 0; level < 64; ++level)
+                {
+                    if (occupied & (std::uint64_t{1} << level))
+                        sum = partials[level] + sum;
+                }
+            }
+            else
+            {
+                for (auto it = first; it != last; ++it)
+                {
+                    sum += *it;
+                }
+            }
+
+            return sum;
         }
 
-        return sum;
+        template <typename T, typename TAccuracy>
+        T contiguous_sum(const T* data, std::size_t size, TAccuracy)
+        {
+            if constexpr (std::is_same_v<TAccuracy, Accuracy::Kahan> && std::is_floating_point_v<T>)
+                return SimdDispatch::sum_kahan(data, size);
+            else if constexpr (std::is_same_v<TAccuracy, Accuracy::Pairwise> && std::is_floating_point_v<T>)
+                return SimdDispatch::sum_pairwise(data, size);
+            else
+                return SimdDispatch::sum_naive(data, size);
+        }
+
+        // equal parts reduced by threads - partial results combined with the same accuracy policy
+        template <typename T, typename TAccuracy>
+        T parallel_sum(const T* data, std::size_t size, TAccuracy accuracy, unsigned thread_count)
+        {
+            std::vector<T> partials(thread_count);
+
+            {
+                std::vector<std::jthread> threads;
+                threads.reserve(thread_count - 1);
+
+                const std::size_t part_size = size / thread_count;
+
+                for (unsigned i = 1; i < thread_count; ++i)
+                {
+                    const std::size_t offset = i * part_size;
+                    const std::size_t count = (i == thread_count - 1) ? size - offset : part_size;
+
+                    threads.emplace_back([=, &partials] { partials[i] = contiguous_sum(data + offset, count, accuracy); });
+                }
+
+                partials[0] = contiguous_sum(data, part_size, accuracy);
+            } // join
+
+            if constexpr (std::is_same_v<TAccuracy, Accuracy::Kahan>)
+                return generic_sum<T>(partials.begin(), partials.end(), accuracy);
+            else
+                return SimdDispatch::sum_pairwise(partials.data(), partials.size()); // tree
+        }
+    } // namespace Reduction
+
+    template <typename T, typename TAccuracy = Accuracy::Naive>
+    auto sum(const T& vec, TAccuracy accuracy = {}) -> std::decay_t<decltype(*std::begin(vec))> // const int
+    {
+        using ValueType = std::decay_t<decltype(*std::begin(vec))>;
+
+        if constexpr (std::contiguous_iterator<decltype(std::begin(vec))> && SimdKernels::Vectorizable<ValueType>)
+        {
+            const ValueType* data = std::to_address(std::begin(vec));
+            const std::size_t size = std::size(vec);
+            const unsigned thread_count = std::max(1u, std::thread::hardware_concurrency());
+
+            if (size >= Reduction::parallel_min_size && thread_count > 1)
+                return Reduction::parallel_sum(data, size, accuracy, thread_count);
+
+            return Reduction::contiguous_sum(data, size, accuracy);
+        }
+        else
+        {
+            return Reduction::generic_sum<ValueType>(std::begin(vec), std::end(vec), accuracy);
+        }
     }
-} // namespace Ver_1
+} // namespace Ver_2
 
 TEST_CASE("type dependent names")
 {
@@ -573,6 +2070,114 @@ TEST_CASE("type dependent names")
     CHECK(result == 10);
 }
 
+TEMPLATE_TEST_CASE("sum - reduction engine", "[sum]", int, std::int8_t, float, double)
+{
+    using T = TestType;
+
+    std::vector<T> data(1'003);
+    for (std::size_t i = 0; i < data.size(); ++i)
+        data[i] = static_cast<T>(i % 7);
+
+    const T expected = Ver_1::sum(data); // exact for small integral values
+
+    CHECK(sum(data) == expected);
+    CHECK(sum(data, Accuracy::Pairwise{}) == expected);
+    CHECK(sum(data, Accuracy::Kahan{}) == expected);
+
+    const std::list<T> lst(data.begin(), data.end());
+    CHECK(sum(lst) == expected);
+    CHECK(sum(lst, Accuracy::Pairwise{}) == expected);
+    CHECK(sum(lst, Accuracy::Kahan{}) == expected);
+
+    for (unsigned thread_count : {2, 3, 8})
+    {
+        CHECK(Reduction::parallel_sum(data.data(), data.size(), Accuracy::Naive{}, thread_count) == expected);
+        CHECK(Reduction::parallel_sum(data.data(), data.size(), Accuracy::Kahan{}, thread_count) == expected);
+    }
+}
+
+TEST_CASE("sum - accuracy of floats", "[sum]")
+{
+    const std::vector<double> data(10'000'000, 0.1);
+    const std::list<double> lst(data.begin(), data.begin() + 1'000'000);
+
+    SECTION("serial loop accumulates rounding errors")
+    {
+        CHECK(std::abs(Ver_1::sum(data) - 1'000'000.0) > 1e-6);
+    }
+
+    SECTION("pairwise")
+    {
+        CHECK(std::abs(sum(data, Accuracy::Pairwise{}) - 1'000'000.0) < 1e-6);
+        CHECK(std::abs(sum(lst, Accuracy::Pairwise{}) - 100'000.0) < 1e-6);
+    }
+
+    SECTION("Kahan")
+    {
+        CHECK(sum(data, Accuracy::Kahan{}) == 1'000'000.0);
+        CHECK(sum(lst, Accuracy::Kahan{}) == 100'000.0);
+        CHECK(Reduction::parallel_sum(data.data(), data.size(), Accuracy::Kahan{}, 4) == 1'000'000.0);
+    }
+}
+
+TEST_CASE("sum - naive/pairwise/Kahan - time & error", "[.benchmark]")
+{
+    std::vector<double> data;
+
+    try
+    {
+        data.resize(1'000'000'000);
+    }
+    catch (const std::bad_alloc&)
+    {
+        WARN("Not enough memory for 1e9 items - using 1e8");
+        data.resize(100'000'000);
+    }
+
+    std::mt19937_64 rnd{42};
+    std::uniform_real_distribution<double> distribution{0.0, 1.0};
+    std::generate(data.begin(), data.end(), [&] { return distribution(rnd); });
+
+    long double exact = 0.0L; // reference - extended precision & compensated
+    long double compensation = 0.0L;
+    for (double item : data)
+    {
+        const long double y = item - compensation;
+        const long double t = exact + y;
+        compensation = (t - exact) - y;
+        exact = t;
+    }
+
+    auto report_error = [&](const char* name, double result) {
+        std::cout << name << " - relative error: " << static_cast<double>(std::abs((result - exact) / exact)) << "\n";
+    };
+
+    report_error("serial loop", Ver_1::sum(data));
+    report_error("naive", sum(data));
+    report_error("pairwise", sum(data, Accuracy::Pairwise{}));
+    report_error("Kahan", sum(data, Accuracy::Kahan{}));
+
+    BENCHMARK("serial loop")
+    {
+        return Ver_1::sum(data);
+    };
+
+    BENCHMARK("naive")
+    {
+        return sum(data);
+    };
+
+    BENCHMARK("pairwise")
+    {
+        return sum(data, Accuracy::Pairwise{});
+    };
+
+    BENCHMARK("Kahan")
+    {
+        return sum(data, Accuracy::Kahan{});
+    };
+}
+
 namespace Lib
 {
     namespace ver_1
@@ -1,4 +1,9 @@
+#include "relocation.hpp"
+
 #include <catch2/catch_test_macros.hpp>
+#include <memory>
+#include <string>
+#include <vector>
 
 int foo(int x)
 {
@@ -108,4 +113,28 @@ TEST_CASE("removing reference from type")
 
     typename RemoveRef<U>::type value1{};
     RemoveRef_t<W> value2{};
-}
\ No newline at end of file
+}
+////////////////////////////////////////////////////////
+// IsTriviallyRelocatable
+
+struct SelfPointing
+{
+    int value;
+    int* ptr = &value;
+
+    SelfPointing(const SelfPointing& other)
+        : value{other.value}
+    {
+    }
+};
+
+TEST_CASE("trivially relocatable types")
+{
+    static_assert(Helpers::IsTriviallyRelocatable_v<int>);
+    static_assert(Helpers::IsTriviallyRelocatable_v<const double>);
+    static_assert(Helpers::IsTriviallyRelocatable_v<std::unique_ptr<std::string>>);
+    static_assert(Helpers::IsTriviallyRelocatable_v<std::shared_ptr<int>>);
+
+    static_assert(!Helpers::IsTriviallyRelocatable_v<SelfPointing>);
+    static_assert(!Helpers::IsTriviallyRelocatable_v<std::vector<int>>); // not marked - conservative default
+}